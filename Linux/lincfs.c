@@ -0,0 +1,46 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sched_engine.h"
+
+static void print_step(struct sched_ctx *c, int idx, double len) {
+    printf("Time %.2f: PID %d runs for %.2f units\n", c->cpu[c->rq].start, c->wl->pid[idx], len);
+}
+
+// ================= COMPLETELY FAIR SCHEDULER =================
+int main(int argc, char **argv) {
+    struct workload wl;
+    struct sched_ctx ctx;
+    struct sched_config cfg = { 0 };
+
+    printf("CampusConnect CFS Scheduler (Linux)\n");
+    if (workload_read(&wl, WL_INPUT_NICE) != 0) return 1;
+
+    printf("Enter Target Latency (0 = %.2f): ", SCHED_CFS_LATENCY);
+    if (scanf("%lf", &cfg.cfs_latency) != 1) cfg.cfs_latency = 0;
+    printf("Enter Minimum Granularity (0 = %.2f): ", SCHED_CFS_MIN_GRAN);
+    if (scanf("%lf", &cfg.cfs_min_gran) != 1) cfg.cfs_min_gran = 0;
+
+    cfg.swap_time = measure_hardware_swap();
+    if (sched_init(&ctx, &wl, &sched_cfs, &cfg) != 0) {
+        fprintf(stderr, "Out of memory for %d processes\n", wl.n);
+        return 1;
+    }
+    if (argc > 1 && sched_log_open(&ctx, argv[1]) != 0) return 1;
+    if (wl.n <= SCHED_TABLE_LIMIT && !ctx.trace) ctx.on_slice = print_step;
+
+    printf("\nStep-by-Step Execution (Latency = %.2f, Min Granularity = %.2f):\n",
+           ctx.cfg.cfs_latency, ctx.cfg.cfs_min_gran);
+    printf("============================================\n");
+    sched_run(&ctx);
+    sched_log_close(&ctx, argv[1]);
+    printf("============================================\n");
+
+    sched_print_table(&ctx, SCHED_ORDER_PID, 0);
+    sched_print_metrics(&ctx);
+
+    sched_free(&ctx);
+    workload_free(&wl);
+    return 0;
+}
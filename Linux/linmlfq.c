@@ -0,0 +1,56 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sched_engine.h"
+
+static void print_step(struct sched_ctx *c, int idx, double len) {
+    printf("Time %.2f: PID %d runs for %.2f units\n", c->cpu[c->rq].start, c->wl->pid[idx], len);
+}
+
+// ================= MULTI-LEVEL FEEDBACK QUEUE SCHEDULER =================
+int main(int argc, char **argv) {
+    struct workload wl;
+    struct sched_ctx ctx;
+    struct sched_config cfg = { 0 };
+
+    printf("CampusConnect MLFQ Scheduler (Linux)\n");
+    if (workload_read(&wl, WL_INPUT_BASIC) != 0) return 1;
+
+    printf("Enter number of queue levels (1-%d): ", SCHED_MLFQ_MAX_LEVELS);
+    if (scanf("%d", &cfg.mlfq_levels) != 1 || cfg.mlfq_levels < 1 ||
+        cfg.mlfq_levels > SCHED_MLFQ_MAX_LEVELS) {
+        fprintf(stderr, "Invalid number of levels\n");
+        return 1;
+    }
+    for (int l = 0; l < cfg.mlfq_levels; l++) {
+        printf("Enter Time Quantum for Q%d: ", l);
+        if (scanf("%lf", &cfg.mlfq_quantum[l]) != 1 || cfg.mlfq_quantum[l] <= 0) {
+            fprintf(stderr, "Invalid time quantum\n");
+            return 1;
+        }
+    }
+    printf("Enter Priority Boost Period (0 = never): ");
+    if (scanf("%lf", &cfg.mlfq_boost) != 1 || cfg.mlfq_boost < 0) cfg.mlfq_boost = 0;
+
+    cfg.swap_time = measure_hardware_swap();
+    if (sched_init(&ctx, &wl, &sched_mlfq, &cfg) != 0) {
+        fprintf(stderr, "Out of memory for %d processes\n", wl.n);
+        return 1;
+    }
+    if (argc > 1 && sched_log_open(&ctx, argv[1]) != 0) return 1;
+    if (wl.n <= SCHED_TABLE_LIMIT && !ctx.trace) ctx.on_slice = print_step;
+
+    printf("\nStep-by-Step Execution (%d Levels):\n", cfg.mlfq_levels);
+    printf("============================================\n");
+    sched_run(&ctx);
+    sched_log_close(&ctx, argv[1]);
+    printf("============================================\n");
+
+    sched_print_table(&ctx, SCHED_ORDER_PID, 0);
+    sched_print_metrics(&ctx);
+
+    sched_free(&ctx);
+    workload_free(&wl);
+    return 0;
+}
@@ -0,0 +1,70 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sched_engine.h"
+
+// ================= SMP SCHEDULER =================
+int main(int argc, char **argv) {
+    char name[32];
+    int ncpu, balance;
+    struct workload wl;
+    struct sched_ctx ctx;
+    struct sched_config cfg = { 0 };
+
+    printf("CampusConnect SMP Scheduler (Linux)\n");
+    printf("Policies:");
+    for (int i = 0; sched_policies[i]; i++) printf(" %s", sched_policies[i]->name);
+    printf("\nEnter policy: ");
+    const struct sched_policy *policy = NULL;
+    if (scanf("%31s", name) != 1 || !(policy = sched_policy_by_name(name))) {
+        fprintf(stderr, "Unknown policy\n");
+        return 1;
+    }
+
+    enum workload_extra extra = WL_INPUT_BASIC;
+    if (policy == &sched_ps) extra = WL_INPUT_PRIORITY;
+    if (policy == &sched_cfs) extra = WL_INPUT_NICE;
+    if (workload_read(&wl, extra) != 0) return 1;
+
+    printf("Enter number of CPUs (1-%d): ", SCHED_MAX_CPUS);
+    if (scanf("%d", &ncpu) != 1 || ncpu < 1 || ncpu > SCHED_MAX_CPUS) {
+        fprintf(stderr, "Invalid number of CPUs\n");
+        return 1;
+    }
+    printf("1. None\n2. Push (periodic)\n3. Work Stealing\n4. Power-of-Two Choices\nEnter balancing: ");
+    if (scanf("%d", &balance) != 1 || balance < 1 || balance > 4) balance = 1;
+    if (balance == 2) {
+        printf("Enter Balance Interval (0 = %.2f): ", SCHED_BALANCE_INTERVAL);
+        if (scanf("%lf", &cfg.balance_interval) != 1) cfg.balance_interval = 0;
+    }
+    if (policy == &sched_rr || policy == &sched_mlfq) {
+        printf("Enter Time Quantum: ");
+        if (scanf("%lf", &cfg.quantum) != 1 || cfg.quantum <= 0) {
+            fprintf(stderr, "Invalid time quantum\n");
+            return 1;
+        }
+    }
+
+    printf("Enter Physical Memory in MB (0 = swap after waiting %.0f units): ", SCHED_SWAP_WAIT);
+    if (scanf("%lf", &cfg.mem_mb) != 1 || cfg.mem_mb < 0) cfg.mem_mb = 0;
+
+    cfg.ncpu = ncpu;
+    cfg.balance = (enum sched_balance)(balance - 1);
+    if (cfg.mem_mb == 0) cfg.swap_time = measure_hardware_swap();
+    if (sched_init(&ctx, &wl, policy, &cfg) != 0) {
+        fprintf(stderr, "Out of memory for %d processes\n", wl.n);
+        return 1;
+    }
+    if (argc > 1 && sched_log_open(&ctx, argv[1]) != 0) return 1;
+    sched_run(&ctx);
+    sched_log_close(&ctx, argv[1]);
+
+    sched_print_table(&ctx, SCHED_ORDER_PID, policy == &sched_ps);
+    sched_print_metrics(&ctx);
+    sched_print_cpus(&ctx);
+
+    sched_free(&ctx);
+    workload_free(&wl);
+    return 0;
+}
@@ -9,6 +9,9 @@
 #include <sys/resource.h>
 #include <string.h>
 
+#include "sched_calib.h"
+#include "sched_switch.h"
+
 #define STUDENT_THREADS 6
 #define SUBMISSIONS_PER_STUDENT 100000
 #define BUFFER_SIZE 4
@@ -37,63 +40,6 @@ int db_before[STUDENT_THREADS];
 int db_after[STUDENT_THREADS];
 
 
-double measure_hardware_swap()
-{
-    FILE *fp = fopen("disk_test.bin", "wb");
-    if (!fp) return 2.0;
-
-    char buffer[1024 * 1024];
-    memset(buffer, 0, sizeof(buffer));
-
-    struct timespec s, e;
-    clock_gettime(CLOCK_MONOTONIC, &s);
-
-    for (int i = 0; i < 5; i++)
-        fwrite(buffer, 1, sizeof(buffer), fp);
-
-    fflush(fp);
-    fclose(fp);
-
-    clock_gettime(CLOCK_MONOTONIC, &e);
-    remove("disk_test.bin");
-
-    double disk_speed =
-        5.0 / ((e.tv_sec - s.tv_sec) + (e.tv_nsec - s.tv_nsec) / 1e9);
-
-    double mem_usage = 10.0;
-
-    FILE *fmem = fopen("/proc/self/status", "r");
-    if (fmem)
-    {
-        char line[256];
-        long kb = 0;
-
-        while (fgets(line, sizeof(line), fmem))
-            if (sscanf(line, "VmRSS: %ld kB", &kb) == 1)
-                break;
-
-        fclose(fmem);
-        mem_usage = kb / 1024.0;
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &s);
-
-    fp = fopen("lat.txt", "w");
-    if (fp)
-    {
-        fputc('A', fp);
-        fclose(fp);
-    }
-
-    clock_gettime(CLOCK_MONOTONIC, &e);
-    remove("lat.txt");
-
-    double latency =
-        (e.tv_sec - s.tv_sec) + (e.tv_nsec - s.tv_nsec) / 1e9;
-
-    return 2 * (latency + (mem_usage / disk_speed));
-}
-
 void* StudentProducer(void* arg)
 {
     int id = *(int*)arg;
@@ -283,6 +229,10 @@ int main()
     printf("\n[ SCHEDULING & STARVATION ]\n");
     printf("Scheduling Latency        : %.6f sec\n", scheduling_latency);
     printf("Forced Context Switches   : %d\n", context_switches);
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    printf("Kernel Context Switches   : %ld voluntary, %ld involuntary\n", ru.ru_nvcsw, ru.ru_nivcsw);
+    printf("Measured Switch Cost      : %.9f units\n", measure_switch_cost());
     printf("Starvation Events         : %d\n", starvation_events);
 
     printf("\n[ PERFORMANCE METRICS ]\n");
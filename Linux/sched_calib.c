@@ -0,0 +1,503 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/statfs.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+
+#if defined(__NR_io_uring_setup) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define CALIB_HAVE_URING 1
+#endif
+#endif
+
+#include "sched_calib.h"
+
+// ================= REAL OS METRICS FUNCTIONS =================
+
+double elapsed_sec(const struct timespec *s, const struct timespec *e) {
+    return (e->tv_sec - s->tv_sec) + (e->tv_nsec - s->tv_nsec) / 1e9;
+}
+
+const int calib_depths[CALIB_NDEPTHS] = { 1, 4, 16 };
+
+#define CALIB_FILE_BYTES (4 << 20)      // test file, overwritten in place
+#define CALIB_POINT_BYTES (4 << 20)     // I/O per point and direction
+#define CALIB_MIN_OPS 32
+#define CALIB_MAX_OPS 256
+#define CALIB_MAX_DEPTH 16
+#define CALIB_BLOCK(b) (1 << (CALIB_MIN_BLOCK_SHIFT + (b)))
+
+/*
+ * One test file and one aligned buffer. `ring` is set while io_uring
+ * works; the first failed submission drops back to the sync path for
+ * the rest of the sweep.
+ */
+struct calib_io {
+    int fd;
+    char *buf;
+#ifdef CALIB_HAVE_URING
+    int ring;
+    unsigned *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sq_ptr, *cq_ptr;
+    size_t sq_size, cq_size, sqe_size;
+#endif
+};
+
+#ifdef CALIB_HAVE_URING
+/* Map the rings of a small io_uring by hand; liburing is not required. */
+static int uring_open(struct calib_io *io) {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    io->ring = (int)syscall(__NR_io_uring_setup, CALIB_MAX_DEPTH, &p);
+    if (io->ring < 0) return -1;
+
+    io->sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    io->cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (io->cq_size > io->sq_size) io->sq_size = io->cq_size;
+        io->cq_size = 0;
+    }
+    io->sq_ptr = mmap(NULL, io->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      io->ring, IORING_OFF_SQ_RING);
+    if (io->sq_ptr == MAP_FAILED) goto fail;
+    io->cq_ptr = io->sq_ptr;
+    if (io->cq_size) {
+        io->cq_ptr = mmap(NULL, io->cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          io->ring, IORING_OFF_CQ_RING);
+        if (io->cq_ptr == MAP_FAILED) {
+            munmap(io->sq_ptr, io->sq_size);
+            goto fail;
+        }
+    }
+    io->sqe_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    io->sqes = mmap(NULL, io->sqe_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    io->ring, IORING_OFF_SQES);
+    if (io->sqes == MAP_FAILED) {
+        if (io->cq_size) munmap(io->cq_ptr, io->cq_size);
+        munmap(io->sq_ptr, io->sq_size);
+        goto fail;
+    }
+
+    char *sq = io->sq_ptr, *cq = io->cq_ptr;
+    io->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+    io->sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+    io->sq_array = (unsigned *)(sq + p.sq_off.array);
+    io->cq_head = (unsigned *)(cq + p.cq_off.head);
+    io->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    io->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+    io->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+    return 0;
+
+fail:
+    close(io->ring);
+    io->ring = -1;
+    return -1;
+}
+
+static void uring_close(struct calib_io *io) {
+    if (io->ring < 0) return;
+    munmap(io->sqes, io->sqe_size);
+    if (io->cq_size) munmap(io->cq_ptr, io->cq_size);
+    munmap(io->sq_ptr, io->sq_size);
+    close(io->ring);
+    io->ring = -1;
+}
+
+/* Submit `n` requests at once and wait for all of them. */
+static int uring_batch(struct calib_io *io, int write, size_t block, off_t off, int n) {
+    unsigned tail = *io->sq_tail;
+    for (int i = 0; i < n; i++) {
+        unsigned slot = (tail + i) & *io->sq_mask;
+        struct io_uring_sqe *sqe = &io->sqes[slot];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = write ? IORING_OP_WRITE : IORING_OP_READ;
+        sqe->fd = io->fd;
+        sqe->addr = (unsigned long)io->buf;
+        sqe->len = (unsigned)block;
+        sqe->off = (unsigned long long)(off + (off_t)i * (off_t)block) % CALIB_FILE_BYTES;
+        io->sq_array[slot] = slot;
+    }
+    __atomic_store_n(io->sq_tail, tail + n, __ATOMIC_RELEASE);
+
+    if (syscall(__NR_io_uring_enter, io->ring, n, n, IORING_ENTER_GETEVENTS, NULL, 0) != n) return -1;
+
+    int rc = 0;
+    unsigned head = *io->cq_head;
+    for (int done = 0; done < n; done++, head++) {
+        while (head == __atomic_load_n(io->cq_tail, __ATOMIC_ACQUIRE))
+            if (syscall(__NR_io_uring_enter, io->ring, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0)
+                return -1;
+        if (io->cqes[head & *io->cq_mask].res != (int)block) rc = -1;
+    }
+    __atomic_store_n(io->cq_head, head, __ATOMIC_RELEASE);
+    return rc;
+}
+#endif
+
+/* A batch of `n` requests; without io_uring they simply run back to back. */
+static int calib_batch(struct calib_io *io, int write, size_t block, off_t off, int n) {
+#ifdef CALIB_HAVE_URING
+    if (io->ring >= 0) {
+        if (uring_batch(io, write, block, off, n) == 0) return 0;
+        uring_close(io);
+    }
+#endif
+    for (int i = 0; i < n; i++) {
+        off_t at = (off + (off_t)i * (off_t)block) % CALIB_FILE_BYTES;
+        ssize_t got = write ? pwrite(io->fd, io->buf, block, at) : pread(io->fd, io->buf, block, at);
+        if (got != (ssize_t)block) return -1;
+    }
+    return 0;
+}
+
+/*
+ * `ops` requests of one size in batches of `depth`. Writes are synced
+ * after every batch, as a swap-out has to reach the device before the
+ * page can be reused; reads start from a dropped page cache.
+ */
+static int calib_point(struct calib_io *io, int write, size_t block, int depth, int ops,
+                       double *lat, double *bw) {
+    struct timespec s, e;
+    if (!write) {
+        fdatasync(io->fd);
+        posix_fadvise(io->fd, 0, 0, POSIX_FADV_DONTNEED);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &s);
+    for (int i = 0; i < ops; i += depth) {
+        if (calib_batch(io, write, block, (off_t)i * (off_t)block, depth) != 0) return -1;
+        if (write && fdatasync(io->fd) != 0) return -1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &e);
+
+    double t = elapsed_sec(&s, &e);
+    *lat = t / (ops / depth);
+    *bw = (double)ops * block / (1 << 20) / t;
+    return 0;
+}
+
+/* Sweep every block size and queue depth against disk_test.bin in the current directory. */
+int calib_measure(struct swap_calib *out) {
+    struct calib_io io;
+    memset(&io, 0, sizeof(io));
+#ifdef CALIB_HAVE_URING
+    io.ring = -1;
+#endif
+
+    out->direct = 1;
+    io.fd = open("disk_test.bin", O_RDWR | O_CREAT | O_TRUNC | O_DIRECT, 0600);
+    if (io.fd < 0 && errno == EINVAL) {
+        out->direct = 0;
+        io.fd = open("disk_test.bin", O_RDWR | O_CREAT | O_TRUNC, 0600);
+    }
+    if (io.fd < 0) return -1;
+    if (posix_memalign((void **)&io.buf, 4096, CALIB_BLOCK(CALIB_NBLOCKS - 1)) != 0) {
+        io.buf = NULL;
+        goto fail;
+    }
+    memset(io.buf, 0xA5, CALIB_BLOCK(CALIB_NBLOCKS - 1));
+
+    // Lay the whole file down first so the sweep only overwrites allocated blocks
+    for (off_t off = 0; off < CALIB_FILE_BYTES; off += CALIB_BLOCK(CALIB_NBLOCKS - 1))
+        if (pwrite(io.fd, io.buf, CALIB_BLOCK(CALIB_NBLOCKS - 1), off) != CALIB_BLOCK(CALIB_NBLOCKS - 1))
+            goto fail;
+    if (fsync(io.fd) != 0) goto fail;
+
+#ifdef CALIB_HAVE_URING
+    uring_open(&io);
+#endif
+    for (int b = 0; b < CALIB_NBLOCKS; b++) {
+        size_t block = CALIB_BLOCK(b);
+        int ops = CALIB_POINT_BYTES / (int)block;
+        if (ops < CALIB_MIN_OPS) ops = CALIB_MIN_OPS;
+        if (ops > CALIB_MAX_OPS) ops = CALIB_MAX_OPS;
+
+        for (int d = 0; d < CALIB_NDEPTHS; d++) {
+            struct calib_point *pt = &out->pt[b][d];
+            if (calib_point(&io, 1, block, calib_depths[d], ops, &pt->write_lat, &pt->write_bw) != 0 ||
+                calib_point(&io, 0, block, calib_depths[d], ops, &pt->read_lat, &pt->read_bw) != 0)
+                goto fail;
+        }
+    }
+#ifdef CALIB_HAVE_URING
+    out->engine = (io.ring >= 0) ? CALIB_IO_URING : CALIB_SYNC;
+    uring_close(&io);
+#else
+    out->engine = CALIB_SYNC;
+#endif
+    free(io.buf);
+    close(io.fd);
+    remove("disk_test.bin");
+    return 0;
+
+fail:
+#ifdef CALIB_HAVE_URING
+    uring_close(&io);
+#endif
+    free(io.buf);
+    close(io.fd);
+    remove("disk_test.bin");
+    return -1;
+}
+
+// ================= SWAP COST MODEL =================
+
+static int page_cluster(void) {
+    int pc = 3;
+    FILE *fp = fopen("/proc/sys/vm/page-cluster", "r");
+    if (fp) {
+        if (fscanf(fp, "%d", &pc) != 1 || pc < 0 || pc > 8) pc = 3;
+        fclose(fp);
+    }
+    return pc;
+}
+
+/* Queue-depth-1 read latency at any size, interpolated on log2(size). */
+static double read_lat_at(const struct swap_calib *c, double bytes) {
+    double x = log2(bytes) - CALIB_MIN_BLOCK_SHIFT;
+    if (x <= 0) return c->pt[0][0].read_lat;
+    if (x >= CALIB_NBLOCKS - 1)
+        return c->pt[CALIB_NBLOCKS - 1][0].read_lat * bytes / CALIB_BLOCK(CALIB_NBLOCKS - 1);
+    int b = (int)x;
+    double f = x - b;
+    return c->pt[b][0].read_lat * (1 - f) + c->pt[b + 1][0].read_lat * f;
+}
+
+void calib_swap_model(const struct swap_calib *c, struct swap_model *m) {
+    double best_bw = 0;
+    for (int b = 0; b < CALIB_NBLOCKS; b++)
+        for (int d = 0; d < CALIB_NDEPTHS; d++)
+            if (c->pt[b][d].write_bw > best_bw) best_bw = c->pt[b][d].write_bw;
+
+    m->write_lat = c->pt[0][0].write_lat;
+    m->write_bw = best_bw * (1 << 20);
+    m->cluster = 4096.0 * (1 << page_cluster());
+    m->cluster_lat = read_lat_at(c, m->cluster);
+}
+
+double swap_out_cost(const struct swap_model *m, double bytes) {
+    return (bytes > 0) ? m->write_lat + bytes / m->write_bw : 0;
+}
+
+double swap_in_cost(const struct swap_model *m, double bytes) {
+    return (bytes > 0) ? ceil(bytes / m->cluster) * m->cluster_lat : 0;
+}
+
+/* Seconds to swap `bytes` out and fault them back in. */
+double calib_swap_cost(const struct swap_calib *c, double bytes) {
+    struct swap_model m;
+    calib_swap_model(c, &m);
+    if (!(m.write_bw > 0)) return 2.0;
+    return swap_out_cost(&m, bytes) + swap_in_cost(&m, bytes);
+}
+
+// ================= CALIBRATION CACHE =================
+
+/*
+ * One line per measured disk: "host dev fstype stamp version engine
+ * direct" followed by the four numbers of every point. Lines for other
+ * disks, and lines of other kinds (sched_switch.c keeps the context
+ * switch cost here), are carried over on every rewrite, and the new
+ * file replaces the old one with rename(), so concurrent runs in a
+ * batch sweep never see a half-written cache. Lines from an older version are ignored
+ * and dropped on the next rewrite.
+ */
+#define CALIB_CACHE_VERSION 2
+#define CALIB_LINE 8192
+
+struct calib_key {
+    char host[64];
+    unsigned long dev;
+    long fstype;
+};
+
+static int calib_key(struct calib_key *k) {
+    struct stat st;
+    struct statfs fs;
+    if (stat(".", &st) != 0 || statfs(".", &fs) != 0) return -1;
+    if (gethostname(k->host, sizeof(k->host)) != 0) return -1;
+    k->host[sizeof(k->host) - 1] = '\0';
+    for (char *p = k->host; *p; p++)
+        if (*p == ' ') *p = '_';
+    k->dev = (unsigned long)st.st_dev;
+    k->fstype = (long)fs.f_type;
+    return 0;
+}
+
+static int mkdir_one(const char *path) {
+    return (mkdir(path, 0755) == 0 || errno == EEXIST) ? 0 : -1;
+}
+
+/* Cache file path; with make_dirs set its directory is created too. */
+int calib_cache_path(char *path, size_t size, int make_dirs) {
+    const char *env = getenv("SCHED_CALIB_CACHE");
+    if (env && *env) {
+        if (snprintf(path, size, "%s", env) >= (int)size) return -1;
+        char *slash = strrchr(path, '/');
+        if (make_dirs && slash && slash != path) {
+            *slash = '\0';
+            int rc = mkdir_one(path);
+            *slash = '/';
+            if (rc != 0) return -1;
+        }
+        return 0;
+    }
+
+    const char *base = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+    char dir[512];
+    if (base && *base)
+        snprintf(dir, sizeof(dir), "%s", base);
+    else if (home && *home)
+        snprintf(dir, sizeof(dir), "%s/.cache", home);
+    else
+        return -1;
+
+    if (make_dirs && mkdir_one(dir) != 0) return -1;
+    if (snprintf(path, size, "%s/campusconnect", dir) >= (int)size) return -1;
+    if (make_dirs && mkdir_one(path) != 0) return -1;
+    return snprintf(path, size, "%s/campusconnect/swap.cache", dir) < (int)size ? 0 : -1;
+}
+
+long calib_cache_ttl(void) {
+    const char *env = getenv("SCHED_CALIB_TTL");
+    return (env && *env) ? atol(env) : CALIB_DEFAULT_TTL;
+}
+
+/* SCHED_RECALIBRATE is set: measure again instead of trusting the cache. */
+int calib_refresh(void) {
+    const char *re = getenv("SCHED_RECALIBRATE");
+    return re && *re && strcmp(re, "0") != 0;
+}
+
+static int same_key(const struct calib_key *a, const char *host, unsigned long dev, long fstype) {
+    return strcmp(a->host, host) == 0 && a->dev == dev && a->fstype == fstype;
+}
+
+/* The curve after the key and stamp of a cache line; -1 if malformed. */
+static int parse_curve(const char *s, struct swap_calib *c) {
+    int version, engine, used;
+    if (sscanf(s, "%d %d %d%n", &version, &engine, &c->direct, &used) != 3 ||
+        version != CALIB_CACHE_VERSION)
+        return -1;
+    c->engine = engine ? CALIB_IO_URING : CALIB_SYNC;
+    s += used;
+
+    for (int b = 0; b < CALIB_NBLOCKS; b++) {
+        for (int d = 0; d < CALIB_NDEPTHS; d++) {
+            double v[4];
+            for (int i = 0; i < 4; i++) {
+                char *end;
+                v[i] = strtod(s, &end);
+                if (end == s || !(v[i] > 0)) return -1;
+                s = end;
+            }
+            c->pt[b][d] = (struct calib_point){ v[0], v[1], v[2], v[3] };
+        }
+    }
+    return 0;
+}
+
+/* Fresh cached curve for this disk; -1 if missing or expired. */
+int calib_load(struct swap_calib *out) {
+    struct calib_key k;
+    char path[640];
+    if (calib_key(&k) != 0 || calib_cache_path(path, sizeof(path), 0) != 0) return -1;
+
+    FILE *fp = fopen(path, "r");
+    if (!fp) return -1;
+
+    static char line[CALIB_LINE];
+    int found = -1;
+    time_t now = time(NULL);
+    while (found != 0 && fgets(line, sizeof(line), fp)) {
+        char host[64];
+        unsigned long dev;
+        long fstype, stamp;
+        int used;
+        if (sscanf(line, "%63s %lu %ld %ld%n", host, &dev, &fstype, &stamp, &used) != 4) continue;
+        if (!same_key(&k, host, dev, fstype)) continue;
+        if (now - stamp > calib_cache_ttl() || now < stamp) continue;
+        if (parse_curve(line + used, out) == 0) found = 0;
+    }
+    fclose(fp);
+    return found;
+}
+
+int calib_store(const struct swap_calib *c) {
+    struct calib_key k;
+    char path[640], tmp[700];
+    if (calib_key(&k) != 0 || calib_cache_path(path, sizeof(path), 1) != 0) return -1;
+
+    snprintf(tmp, sizeof(tmp), "%s.%ld", path, (long)getpid());
+    FILE *out = fopen(tmp, "w");
+    if (!out) return -1;
+
+    FILE *in = fopen(path, "r");
+    if (in) {
+        static char line[CALIB_LINE];
+        while (fgets(line, sizeof(line), in)) {
+            char host[64];
+            unsigned long dev;
+            long fstype;
+            if (sscanf(line, "%63s %lu %ld", host, &dev, &fstype) == 3 && same_key(&k, host, dev, fstype))
+                continue;
+            fputs(line, out);
+        }
+        fclose(in);
+    }
+    fprintf(out, "%s %lu %ld %ld %d %d %d", k.host, k.dev, k.fstype, (long)time(NULL),
+            CALIB_CACHE_VERSION, (int)c->engine, c->direct);
+    for (int b = 0; b < CALIB_NBLOCKS; b++)
+        for (int d = 0; d < CALIB_NDEPTHS; d++)
+            fprintf(out, " %.6g %.6g %.6g %.6g", c->pt[b][d].write_lat, c->pt[b][d].read_lat,
+                    c->pt[b][d].write_bw, c->pt[b][d].read_bw);
+    fputc('\n', out);
+
+    if (fclose(out) != 0 || rename(tmp, path) != 0) {
+        remove(tmp);
+        return -1;
+    }
+    return 0;
+}
+
+static double rss_bytes(void) {
+    double mem_usage = 10.0 * (1 << 20);
+    FILE *fmem = fopen("/proc/self/status", "r");
+    if (fmem) {
+        char line[256];
+        long kb = 0;
+        while (fgets(line, sizeof(line), fmem))
+            if (sscanf(line, "VmRSS: %ld kB", &kb) == 1) break;
+        fclose(fmem);
+        mem_usage = kb * 1024.0;
+    }
+    return mem_usage;
+}
+
+/* The cached curve for this disk, measured (and cached) first if need be. */
+int calib_get(struct swap_calib *out) {
+    if (!calib_refresh() && calib_load(out) == 0) return 0;
+    if (calib_measure(out) != 0) return -1;
+    calib_store(out);
+    return 0;
+}
+
+/* Seconds to swap this process's resident set out and back in. */
+double measure_hardware_swap(void) {
+    struct swap_calib c;
+    if (calib_get(&c) != 0) return 2.0;
+    return calib_swap_cost(&c, rss_bytes());
+}
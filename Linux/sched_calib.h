@@ -0,0 +1,70 @@
+#ifndef SCHED_CALIB_H
+#define SCHED_CALIB_H
+
+#include <stddef.h>
+#include <time.h>
+
+// ================= REAL OS METRICS FUNCTIONS =================
+
+/*
+ * The swap cost comes from timing the current directory's disk with
+ * O_DIRECT reads and synced O_DIRECT writes, block sizes 4 KB to 1 MB,
+ * at several queue depths (io_uring, or back-to-back pread/pwrite where
+ * io_uring is missing). The resulting curve is cached per host, device
+ * and filesystem, so only the first run on a disk (and the first after
+ * the entry expires) pays for it:
+ *   SCHED_CALIB_CACHE   cache file (default $XDG_CACHE_HOME or
+ *                       ~/.cache, then campusconnect/swap.cache)
+ *   SCHED_CALIB_TTL     entry lifetime in seconds (default one week)
+ *   SCHED_RECALIBRATE=1 measure again and refresh the entry
+ */
+#define CALIB_DEFAULT_TTL (7 * 24 * 3600L)
+#define CALIB_MIN_BLOCK_SHIFT 12    // 4 KB
+#define CALIB_NBLOCKS 9             // 4 KB ... 1 MB
+#define CALIB_NDEPTHS 3
+
+extern const int calib_depths[CALIB_NDEPTHS];
+
+enum calib_engine { CALIB_SYNC, CALIB_IO_URING };
+
+/* Per request: seconds until the batch it was submitted with completed. */
+struct calib_point {
+    double write_lat, read_lat;
+    double write_bw, read_bw;       // MB/s
+};
+
+struct swap_calib {
+    enum calib_engine engine;
+    int direct;                     // 0 if the filesystem refused O_DIRECT
+    struct calib_point pt[CALIB_NBLOCKS][CALIB_NDEPTHS];
+};
+
+/*
+ * The curve reduced to what a swap costs: swap-out is written back in
+ * bulk, one small synced write plus the bytes at the best synced write
+ * bandwidth of the sweep; swap-in faults pages back one readahead
+ * cluster (2^vm.page-cluster pages) at a time, each a queue-depth-1
+ * read.
+ */
+struct swap_model {
+    double write_lat;       // seconds
+    double write_bw;        // bytes per second
+    double cluster;         // bytes per swap-in read
+    double cluster_lat;     // seconds per swap-in read
+};
+
+int    calib_measure(struct swap_calib *out);
+int    calib_load(struct swap_calib *out);
+int    calib_store(const struct swap_calib *c);
+int    calib_get(struct swap_calib *out);
+void   calib_swap_model(const struct swap_calib *c, struct swap_model *m);
+double swap_out_cost(const struct swap_model *m, double bytes);
+double swap_in_cost(const struct swap_model *m, double bytes);
+double calib_swap_cost(const struct swap_calib *c, double bytes);
+double measure_hardware_swap(void);
+int    calib_cache_path(char *path, size_t size, int make_dirs);
+long   calib_cache_ttl(void);
+int    calib_refresh(void);
+double elapsed_sec(const struct timespec *s, const struct timespec *e);
+
+#endif
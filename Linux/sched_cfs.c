@@ -0,0 +1,160 @@
+#include <stdlib.h>
+
+#include "sched_engine.h"
+#include "sched_queue.h"
+
+// ================= CFS POLICY =================
+
+/*
+ * Completely Fair Scheduler model. Runnable jobs sit in a red-black tree
+ * ordered by vruntime, and the leftmost (least served) job runs next.
+ * Running for t units advances vruntime by t * NICE_0_LOAD / weight, so
+ * heavier (lower nice) jobs accrue it more slowly. A slice is the job's
+ * weight share of the scheduling period, which is the target latency,
+ * stretched to nr_running * min_granularity when crowded. New jobs
+ * start at min_vruntime, and an arrival preempts the running job once
+ * that job is more than wakeup_granularity ahead of it.
+ *
+ * Each CPU has its own tree and min_vruntime. A job moved to another
+ * CPU keeps its lag: its vruntime is shifted by the difference of the
+ * two queues' min_vruntime, as migrate_task_rq_fair() does.
+ */
+#define NICE_0_LOAD 1024.0
+
+/* Linux sched_prio_to_weight[], nice -20 .. 19. */
+static const int nice_to_weight[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+     9548,  7620,  6100,  4904,  3906,
+     3121,  2501,  1991,  1586,  1277,
+     1024,   820,   655,   526,   423,
+      335,   272,   215,   172,   137,
+      110,    87,    70,    56,    45,
+       36,    29,    23,    18,    15,
+};
+
+struct cfs_rq {
+    struct rbtree tree;
+    double min_vruntime;
+    double queued_weight;
+};
+
+struct cfs_state {
+    struct cfs_rq *rq;          // one per CPU, all linked through rq[0].tree
+    double *vruntime;
+    double *rem_at_dispatch;    // -1 while waiting
+    int *last_rq;               // queue the job last waited on, -1 before arrival
+};
+
+static inline double job_weight(const struct sched_ctx *c, int idx) {
+    int nice = c->wl->nice ? c->wl->nice[idx] : 0;
+    if (nice < -20) nice = -20;
+    if (nice > 19) nice = 19;
+    return nice_to_weight[nice + 20];
+}
+
+static void cfs_destroy(struct sched_ctx *c) {
+    struct cfs_state *s = c->pdata;
+    if (!s) return;
+    if (s->rq)
+        for (int k = 0; k < c->cfg.ncpu; k++) rb_free(&s->rq[k].tree);
+    free(s->rq);
+    free(s->vruntime);
+    free(s->rem_at_dispatch);
+    free(s->last_rq);
+    free(s);
+}
+
+static int cfs_init(struct sched_ctx *c) {
+    int n = c->wl->n;
+    struct cfs_state *s = calloc(1, sizeof(*s));
+    if (!s) return -1;
+    c->pdata = s;
+
+    s->vruntime = calloc(n, sizeof(double));
+    s->rem_at_dispatch = malloc((size_t)n * sizeof(double));
+    s->last_rq = malloc((size_t)n * sizeof(int));
+    s->rq = calloc(c->cfg.ncpu, sizeof(*s->rq));
+    if (!s->vruntime || !s->rem_at_dispatch || !s->last_rq || !s->rq ||
+        rb_init(&s->rq[0].tree, n) != 0) {
+        cfs_destroy(c);
+        c->pdata = NULL;
+        return -1;
+    }
+    for (int k = 1; k < c->cfg.ncpu; k++) rb_init_shared(&s->rq[k].tree, &s->rq[0].tree);
+    for (int i = 0; i < n; i++) {
+        s->rem_at_dispatch[i] = -1;
+        s->last_rq[i] = -1;
+    }
+    return 0;
+}
+
+static int cfs_enqueue(struct sched_ctx *c, int idx) {
+    struct cfs_state *s = c->pdata;
+    struct cfs_rq *rq = &s->rq[c->rq];
+    double w = job_weight(c, idx);
+    int from = s->last_rq[idx];
+
+    if (s->rem_at_dispatch[idx] >= 0) {
+        double ran = s->rem_at_dispatch[idx] - c->p.rem[idx];
+        s->vruntime[idx] += ran * NICE_0_LOAD / w;
+        s->rem_at_dispatch[idx] = -1;
+    } else {
+        if (from >= 0 && from != c->rq)
+            s->vruntime[idx] += rq->min_vruntime - s->rq[from].min_vruntime;
+        if (s->vruntime[idx] < rq->min_vruntime) s->vruntime[idx] = rq->min_vruntime;
+    }
+    s->last_rq[idx] = c->rq;
+
+    rb_insert(&rq->tree, idx, s->vruntime[idx]);
+    rq->queued_weight += w;
+
+    // min_vruntime only moves forward
+    double left = s->vruntime[rb_first(&rq->tree)];
+    if (left > rq->min_vruntime) rq->min_vruntime = left;
+    return 0;
+}
+
+static int cfs_pick(struct sched_ctx *c) {
+    struct cfs_state *s = c->pdata;
+    struct cfs_rq *rq = &s->rq[c->rq];
+    int idx = rb_first(&rq->tree);
+    if (idx < 0) return -1;
+
+    rb_erase(&rq->tree, idx);
+    rq->queued_weight -= job_weight(c, idx);
+    return idx;
+}
+
+static double cfs_slice(struct sched_ctx *c, int idx) {
+    struct cfs_state *s = c->pdata;
+    struct cfs_rq *rq = &s->rq[c->rq];
+    double w = job_weight(c, idx);
+    double nr = rq->tree.len + 1;
+    double period = c->cfg.cfs_latency;
+
+    if (nr * c->cfg.cfs_min_gran > period) period = nr * c->cfg.cfs_min_gran;
+    double slice = period * w / (rq->queued_weight + w);
+    if (slice < c->cfg.cfs_min_gran) slice = c->cfg.cfs_min_gran;
+
+    double rem = c->p.rem[idx];
+    s->rem_at_dispatch[idx] = rem;
+    return (rem > slice) ? slice : rem;
+}
+
+static int cfs_preempts(struct sched_ctx *c, int running, int idx) {
+    struct cfs_state *s = c->pdata;
+    double ran = s->rem_at_dispatch[running] - sched_running_rem(c);
+    double curr = s->vruntime[running] + ran * NICE_0_LOAD / job_weight(c, running);
+    return curr - s->vruntime[idx] > c->cfg.cfs_wakeup_gran;
+}
+
+const struct sched_policy sched_cfs = {
+    .name = "CFS",
+    .init = cfs_init,
+    .destroy = cfs_destroy,
+    .enqueue = cfs_enqueue,
+    .pick = cfs_pick,
+    .slice = cfs_slice,
+    .preempts = cfs_preempts,
+};
@@ -0,0 +1,714 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <time.h>
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "sched_engine.h"
+#include "sched_incr.h"
+#include "sched_scan.h"
+#include "sched_simd.h"
+
+// ================= ENGINE =================
+
+const struct sched_policy *const sched_policies[] = {
+    &sched_fcfs, &sched_sjf, &sched_srtf, &sched_rr, &sched_ps, &sched_mlfq, &sched_cfs, NULL
+};
+
+const char *const sched_balance_names[] = { "none", "push", "steal", "p2c", NULL };
+
+const struct sched_policy *sched_policy_by_name(const char *name) {
+    for (int i = 0; sched_policies[i]; i++)
+        if (strcasecmp(sched_policies[i]->name, name) == 0) return sched_policies[i];
+    return NULL;
+}
+
+/* Stable arrival order; traces are usually sorted already so check first. */
+static int sort_by_arrival(const struct workload *wl, int *out, int threads) {
+    int sorted = 1;
+    for (int i = 0; i < wl->n; i++) {
+        out[i] = i;
+        if (i > 0 && wl->at[i] < wl->at[i - 1]) sorted = 0;
+    }
+    return sorted ? 0 : radix_sort_by_key(wl->at, wl->n, out, threads);
+}
+
+/*
+ * Used when this disk cannot be calibrated: a SATA SSD, 400 MB/s synced
+ * writes and 100 us per 32 KB swap-in read.
+ */
+static const struct swap_model nominal_swap_dev = { 50e-6, 400.0 * 1024 * 1024, 32768, 100e-6 };
+
+static int init_mem(struct sched_ctx *c) {
+    if (c->cfg.job_mem_mb <= 0) c->cfg.job_mem_mb = SCHED_JOB_MEM_MB;
+    if (!(c->cfg.swap_dev.write_bw > 0)) {
+        struct swap_calib cal;
+        if (calib_get(&cal) == 0)
+            calib_swap_model(&cal, &c->cfg.swap_dev);
+        if (!(c->cfg.swap_dev.write_bw > 0)) c->cfg.swap_dev = nominal_swap_dev;
+    }
+
+    c->mem = malloc(sizeof(*c->mem));
+    if (!c->mem) return -1;
+    if (mem_init(c->mem, c->wl, c->cfg.mem_mb, c->cfg.job_mem_mb, &c->cfg.swap_dev) != 0) {
+        free(c->mem);
+        c->mem = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+static int proc_alloc(struct proc_table *p, int n) {
+    size_t d = (size_t)n * sizeof(double);
+    memset(p, 0, sizeof(*p));
+    p->rem = malloc(d);
+    p->ready = calloc((size_t)n, sizeof(double));
+    p->started = calloc((size_t)n, 1);
+    p->preempted = calloc((size_t)n, sizeof(int));
+    p->switch_base = calloc((size_t)n, sizeof(double));
+    p->st = calloc((size_t)n, sizeof(double));
+    p->ft = calloc((size_t)n, sizeof(double));
+    p->wt = calloc((size_t)n, sizeof(double));
+    p->tat = calloc((size_t)n, sizeof(double));
+    p->rt = calloc((size_t)n, sizeof(double));
+    if (!p->rem || !p->ready || !p->started || !p->preempted || !p->switch_base || !p->st ||
+        !p->ft || !p->wt || !p->tat || !p->rt)
+        return -1;
+    return 0;
+}
+
+static void proc_free(struct proc_table *p) {
+    free(p->rem);
+    free(p->ready);
+    free(p->started);
+    free(p->preempted);
+    free(p->switch_base);
+    free(p->st);
+    free(p->ft);
+    free(p->wt);
+    free(p->tat);
+    free(p->rt);
+    memset(p, 0, sizeof(*p));
+}
+
+int sched_init(struct sched_ctx *c, const struct workload *wl,
+               const struct sched_policy *policy, const struct sched_config *cfg) {
+    memset(c, 0, sizeof(*c));
+    c->wl = wl;
+    c->policy = policy;
+    c->cfg = *cfg;
+    if (c->cfg.prio_levels <= 0) c->cfg.prio_levels = SCHED_PRIO_LEVELS;
+    if (c->cfg.quantum <= 0) c->cfg.quantum = SCHED_DEFAULT_QUANTUM;
+    if (c->cfg.mlfq_levels <= 0) c->cfg.mlfq_levels = SCHED_MLFQ_LEVELS;
+    if (c->cfg.mlfq_levels > SCHED_MLFQ_MAX_LEVELS) c->cfg.mlfq_levels = SCHED_MLFQ_MAX_LEVELS;
+    if (c->cfg.cfs_latency <= 0) c->cfg.cfs_latency = SCHED_CFS_LATENCY;
+    if (c->cfg.cfs_min_gran <= 0) c->cfg.cfs_min_gran = SCHED_CFS_MIN_GRAN;
+    if (c->cfg.cfs_wakeup_gran <= 0) c->cfg.cfs_wakeup_gran = SCHED_CFS_WAKEUP_GRAN;
+    for (int l = 0; l < c->cfg.mlfq_levels; l++)
+        if (c->cfg.mlfq_quantum[l] <= 0) c->cfg.mlfq_quantum[l] = c->cfg.quantum * (1 << l);
+    if (c->cfg.ncpu <= 0) c->cfg.ncpu = 1;
+    if (c->cfg.ncpu > SCHED_MAX_CPUS) c->cfg.ncpu = SCHED_MAX_CPUS;
+    if (c->cfg.balance_interval <= 0) c->cfg.balance_interval = SCHED_BALANCE_INTERVAL;
+    c->rng = c->cfg.seed ? c->cfg.seed : 0x9e3779b97f4a7c15ULL;
+
+    if (proc_alloc(&c->p, wl->n) != 0) goto fail;
+    c->by_arrival = malloc((size_t)wl->n * sizeof(int));
+    c->done_order = malloc((size_t)wl->n * sizeof(int));
+    c->cpu = calloc(c->cfg.ncpu, sizeof(struct sched_cpu));
+    c->hist = malloc(SCHED_METRICS * sizeof(struct sched_hist));
+    if (!c->by_arrival || !c->done_order || !c->cpu || !c->hist) goto fail;
+    for (int m = 0; m < SCHED_METRICS; m++) hist_reset(&c->hist[m]);
+    if (calq_init(&c->events) != 0) goto fail;
+    for (int k = 0; k < c->cfg.ncpu; k++) c->cpu[k].running = c->cpu[k].preempted = -1;
+    if (sort_by_arrival(wl, c->by_arrival, c->cfg.threads) != 0) goto fail;
+
+    memcpy(c->p.rem, wl->bt, (size_t)wl->n * sizeof(double));
+    if (c->cfg.mem_mb > 0 && init_mem(c) != 0) goto fail;
+
+    if (policy->init && policy->init(c) != 0) goto fail;
+    return 0;
+
+fail:
+    sched_free(c);
+    return -1;
+}
+
+void sched_free(struct sched_ctx *c) {
+    if (c->policy && c->policy->destroy) c->policy->destroy(c);
+    proc_free(&c->p);
+    free(c->by_arrival);
+    free(c->done_order);
+    free(c->cpu);
+    free(c->hist);
+    if (c->mem) mem_free(c->mem);
+    free(c->mem);
+    calq_free(&c->events);
+    incr_free(c->incr);
+    c->incr = NULL;
+    c->by_arrival = NULL;
+    c->done_order = NULL;
+    c->cpu = NULL;
+    c->hist = NULL;
+    c->mem = NULL;
+    c->pdata = NULL;
+}
+
+/* Start a binary event log for this run (see schedlog for the text view). */
+int sched_log_open(struct sched_ctx *c, const char *path) {
+    c->trace = trace_open(path, c->cfg.ncpu);
+    if (!c->trace) {
+        fprintf(stderr, "Cannot create event log %s\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+void sched_log_close(struct sched_ctx *c, const char *path) {
+    if (!c->trace) return;
+    int64_t n = trace_close(c->trace);
+    c->trace = NULL;
+    if (n < 0)
+        fprintf(stderr, "Error writing event log %s\n", path);
+    else
+        printf("Event Log: %lld records written to %s\n", (long long)n, path);
+}
+
+/* Only the next arrival sits in the event set; the cursor streams the rest. */
+static int schedule_next_arrival(struct sched_ctx *c) {
+    if (c->next_arrival >= c->wl->n) return 0;
+
+    int idx = c->by_arrival[c->next_arrival++];
+    struct sched_event ev = { .time = c->wl->at[idx], .type = EV_ARRIVAL, .idx = idx };
+    return calq_push(&c->events, &ev);
+}
+
+/* Results only; the sums, extremes and utilization are aggregated once the run is over. */
+static void finish(struct sched_ctx *c, int idx) {
+    struct proc_table *p = &c->p;
+    double ft = c->now;
+    double tat = ft - c->wl->at[idx];
+    double wt = tat - c->wl->bt[idx];
+
+    p->ft[idx] = ft;
+    p->tat[idx] = tat;
+    p->wt[idx] = wt;
+    c->done_order[c->completed++] = idx;
+
+    hist_add(&c->hist[METRIC_WT], wt);
+    hist_add(&c->hist[METRIC_TAT], tat);
+    hist_add(&c->hist[METRIC_RT], p->rt[idx]);
+}
+
+/* Totals and extremes of the result columns, streamed through the column kernels. */
+void sched_aggregate(struct sched_ctx *c) {
+    struct sched_stats *s = &c->stats;
+    size_t n = (size_t)c->wl->n;
+    struct col_stats cs;
+
+    col_stats(c->p.wt, n, &cs);
+    s->total_wt = cs.sum;
+    s->min_wt = cs.min;
+    s->max_wt = cs.max;
+    col_stats(c->p.tat, n, &cs);
+    s->total_tat = cs.sum;
+    s->min_tat = cs.min;
+    s->max_tat = cs.max;
+    s->total_rt = col_sum(c->p.rt, n);
+    s->total_bt = col_sum(c->wl->bt, n);
+    s->max_ft = col_max(c->p.ft, n);
+    s->max_preempted = col_max_int(c->p.preempted, n);
+}
+
+// ================= RUN QUEUES AND BALANCING =================
+
+static inline int cpu_load(const struct sched_ctx *c, int k) {
+    return c->cpu[k].nr_queued + (c->cpu[k].running >= 0);
+}
+
+static inline uint64_t next_rand(struct sched_ctx *c) {
+    c->rng ^= c->rng >> 12;
+    c->rng ^= c->rng << 25;
+    c->rng ^= c->rng >> 27;
+    return c->rng * 0x2545f4914f6cdd1dULL;
+}
+
+static int arm_balance(struct sched_ctx *c) {
+    if (c->cfg.balance != SCHED_BALANCE_PUSH || c->cfg.ncpu == 1 || c->balance_armed) return 0;
+
+    double every = c->cfg.balance_interval;
+    struct sched_event ev = { .time = (floor(c->now / every) + 1) * every, .type = EV_BALANCE };
+    c->balance_armed = 1;
+    return calq_push(&c->events, &ev);
+}
+
+static int rq_enqueue(struct sched_ctx *c, int k, int idx) {
+    struct sched_cpu *cpu = &c->cpu[k];
+
+    c->rq = k;
+    if (c->policy->enqueue(c, idx) != 0) return -1;
+    if (++cpu->nr_queued > cpu->max_queued) cpu->max_queued = cpu->nr_queued;
+    c->nr_queued++;
+    return arm_balance(c);
+}
+
+static int rq_pick(struct sched_ctx *c, int k) {
+    c->rq = k;
+    c->pick_aged = 0;
+    int idx = c->policy->pick(c);
+    if (idx >= 0) {
+        c->cpu[k].nr_queued--;
+        c->nr_queued--;
+    }
+    return idx;
+}
+
+/* Move the job queue `from` would run next onto queue `to`. */
+static int migrate(struct sched_ctx *c, int from, int to) {
+    int idx = rq_pick(c, from);
+    if (idx < 0) return 0;
+    c->p.switch_base[idx] += c->cpu[to].switched - c->cpu[from].switched;
+    c->stats.migrations++;
+    c->cpu[to].migrations++;
+    return rq_enqueue(c, to, idx);
+}
+
+/* Round-robin, or the less loaded of two distinct random CPUs. */
+static int place(struct sched_ctx *c) {
+    int n = c->cfg.ncpu;
+    if (n == 1) return 0;
+
+    if (c->cfg.balance == SCHED_BALANCE_P2C) {
+        int a = next_rand(c) % n;
+        int b = next_rand(c) % (n - 1);
+        if (b >= a) b++;
+        return (cpu_load(c, b) < cpu_load(c, a)) ? b : a;
+    }
+
+    int k = c->next_cpu;
+    if (++c->next_cpu == n) c->next_cpu = 0;
+    return k;
+}
+
+/* Push from the busiest CPU to the idlest until their loads are within one. */
+static int push_balance(struct sched_ctx *c) {
+    c->balance_armed = 0;
+    for (;;) {
+        int busiest = 0, idlest = 0;
+        for (int k = 1; k < c->cfg.ncpu; k++) {
+            if (cpu_load(c, k) > cpu_load(c, busiest)) busiest = k;
+            if (cpu_load(c, k) < cpu_load(c, idlest)) idlest = k;
+        }
+        if (cpu_load(c, busiest) - cpu_load(c, idlest) <= 1 || c->cpu[busiest].nr_queued == 0)
+            break;
+        if (migrate(c, busiest, idlest) != 0) return -1;
+    }
+    return (c->nr_queued > 0) ? arm_balance(c) : 0;
+}
+
+/* A CPU whose queue ran dry takes one job from the longest queue. */
+static int steal(struct sched_ctx *c, int thief) {
+    int victim = -1;
+    for (int k = 0; k < c->cfg.ncpu; k++)
+        if (k != thief && c->cpu[k].nr_queued > 0 &&
+            (victim < 0 || c->cpu[k].nr_queued > c->cpu[victim].nr_queued))
+            victim = k;
+    return (victim < 0) ? 0 : migrate(c, victim, thief);
+}
+
+static void account_load(struct sched_ctx *c, double dt) {
+    if (c->cfg.ncpu == 1) return;
+
+    int hi = cpu_load(c, 0), lo = hi;
+    for (int k = 1; k < c->cfg.ncpu; k++) {
+        int l = cpu_load(c, k);
+        if (l > hi) hi = l;
+        if (l < lo) lo = l;
+    }
+    c->stats.load_imbalance += (hi - lo) * dt;
+}
+
+// ================= EVENT LOOP =================
+
+/* Start CPU k's next ready job and schedule the end of its slice. */
+static int dispatch(struct sched_ctx *c, int k) {
+    const double *at = c->wl->at;
+    struct sched_cpu *cpu = &c->cpu[k];
+    struct timespec ls, le;
+
+    int may_steal = c->cfg.balance == SCHED_BALANCE_STEAL && c->nr_queued > 0;
+    if (cpu->nr_queued == 0 && !may_steal) return 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &ls);
+    if (cpu->nr_queued == 0 && steal(c, k) != 0) return -1;
+    int idx = rq_pick(c, k);
+    if (idx < 0) return 0;
+
+    struct proc_table *p = &c->p;
+    double start = c->now;
+
+    /*
+     * The legacy swap rule judges the wait without the switch charges it
+     * sat through: they only shift this CPU's clock by microseconds, and
+     * must not tip a wait of exactly SCHED_SWAP_WAIT. Taking them back
+     * out may leave a few ulps, hence the slack; with none it is exact.
+     */
+    double seen = cpu->switched - p->switch_base[idx];
+    int waited = (seen > 0) ? (c->now - at[idx]) - seen > SCHED_SWAP_WAIT * (1 + 8 * DBL_EPSILON)
+                            : (c->now - at[idx]) > SCHED_SWAP_WAIT;
+
+    // A preemption only costs a switch when another job gets the CPU
+    if (cpu->preempted >= 0 && cpu->preempted != idx && c->cfg.switch_cost > 0) {
+        start += c->cfg.switch_cost;
+        cpu->switched += c->cfg.switch_cost;
+        c->stats.switches++;
+        c->stats.switch_overhead += c->cfg.switch_cost;
+    }
+    cpu->preempted = -1;
+
+    double stall = 0;
+    if (c->mem)
+        stall = mem_acquire(c->mem, idx, start);
+    else if (waited)
+        stall = c->cfg.swap_time;
+    if (stall > 0) {
+        if (c->trace)
+            trace_emit(c->trace, TR_SWAP, k, c->wl->pid[idx], start, stall, cpu->nr_queued);
+        start += stall;
+        c->stats.total_swaps++;
+        c->stats.swap_stall += stall;
+    }
+
+    if (!p->started[idx]) {
+        p->st[idx] = start;
+        p->rt[idx] = start - at[idx];
+        p->started[idx] = 1;
+    }
+
+    cpu->running = idx;
+    cpu->start = start;
+    cpu->len = c->policy->slice(c, idx);
+    if (c->on_slice) c->on_slice(c, idx, cpu->len);
+    if (c->trace)
+        trace_emit(c->trace, TR_DISPATCH, k, c->wl->pid[idx], start, cpu->len, cpu->nr_queued);
+    cpu->dispatches++;
+    c->stats.dispatches++;
+    if (c->pick_aged) c->stats.aged_dispatches++;
+
+    struct sched_event ev = {
+        .time = cpu->start + cpu->len, .type = EV_SLICE_END, .idx = idx, .cpu = k, .gen = cpu->gen
+    };
+    int rc = calq_push(&c->events, &ev);
+
+    clock_gettime(CLOCK_MONOTONIC, &le);
+    c->stats.sched_latency += elapsed_sec(&ls, &le);
+    return rc;
+}
+
+static int slice_end(struct sched_ctx *c, const struct sched_event *ev) {
+    struct sched_cpu *cpu = &c->cpu[ev->cpu];
+    if (ev->gen != cpu->gen || cpu->running != ev->idx) return 0;
+
+    int idx = ev->idx;
+    struct proc_table *p = &c->p;
+    p->rem[idx] -= cpu->len;
+    cpu->busy += cpu->len;
+    cpu->running = -1;
+    cpu->gen++;
+
+    if (p->rem[idx] > 0) {
+        c->stats.preemptions++;
+        p->preempted[idx]++;
+        cpu->preempted = idx;
+        p->ready[idx] = c->now;
+        if (c->mem) mem_release(c->mem, idx);
+        if (rq_enqueue(c, ev->cpu, idx) != 0) return -1;
+        if (c->trace)
+            trace_emit(c->trace, TR_PREEMPT, ev->cpu, c->wl->pid[idx], c->now, p->rem[idx], cpu->nr_queued);
+        return 0;
+    }
+    finish(c, idx);
+    if (c->mem) mem_exit(c->mem, idx);
+    if (c->trace)
+        trace_emit(c->trace, TR_COMPLETE, ev->cpu, c->wl->pid[idx], c->now, p->tat[idx], cpu->nr_queued);
+    return 0;
+}
+
+/* Remaining burst of the job running on CPU c->rq as of now (a swap-in counts as no progress). */
+double sched_running_rem(const struct sched_ctx *c) {
+    const struct sched_cpu *cpu = &c->cpu[c->rq];
+    double ran = c->now - cpu->start;
+    if (ran < 0) ran = 0;
+    return c->p.rem[cpu->running] - ran;
+}
+
+/* Take CPU k back mid-slice; the pending slice end goes stale. */
+static int preempt(struct sched_ctx *c, int k) {
+    struct sched_cpu *cpu = &c->cpu[k];
+    int idx = cpu->running;
+    struct proc_table *p = &c->p;
+
+    c->rq = k;
+    double rem = sched_running_rem(c);
+    cpu->busy += p->rem[idx] - rem;
+    p->rem[idx] = rem;
+    cpu->running = -1;
+    cpu->gen++;
+    c->stats.preemptions++;
+    p->preempted[idx]++;
+    cpu->preempted = idx;
+    p->ready[idx] = c->now;
+    if (c->mem) mem_release(c->mem, idx);
+    if (rq_enqueue(c, k, idx) != 0) return -1;
+    if (c->trace) trace_emit(c->trace, TR_PREEMPT, k, c->wl->pid[idx], c->now, rem, cpu->nr_queued);
+    return 0;
+}
+
+static int arrival(struct sched_ctx *c, int idx) {
+    int k = place(c);
+
+    c->p.ready[idx] = c->now;
+    c->p.switch_base[idx] = c->cpu[k].switched;
+    if (c->mem) mem_arrive(c->mem, idx);
+    if (rq_enqueue(c, k, idx) != 0) return -1;
+    if (c->trace)
+        trace_emit(c->trace, TR_ARRIVAL, k, c->wl->pid[idx], c->now, c->wl->bt[idx], c->cpu[k].nr_queued);
+
+    int running = c->cpu[k].running;
+    if (running >= 0 && c->policy->preempts &&
+        c->policy->preempts(c, running, idx) && preempt(c, k) != 0)
+        return -1;
+    return schedule_next_arrival(c);
+}
+
+/*
+ * Discrete-event loop. Time jumps from one event to the next, so idle
+ * gaps cost nothing however long they are. All events sharing a
+ * timestamp are applied before idle CPUs pick their next jobs; arrivals
+ * sort ahead of slice ends, so a job arriving as a slice expires queues
+ * in front of the preempted one.
+ */
+static int event_loop(struct sched_ctx *c) {
+    struct sched_event ev, next;
+
+    if (schedule_next_arrival(c) != 0) return -1;
+
+    while (c->completed < c->wl->n) {
+        if (calq_pop(&c->events, &ev) != 0) return -1;
+        if (ev.time > c->now) {
+            account_load(c, ev.time - c->now);
+            c->now = ev.time;
+        }
+
+        int rc = 0;
+        switch (ev.type) {
+        case EV_ARRIVAL:
+            rc = arrival(c, ev.idx);
+            break;
+        case EV_SLICE_END:
+            rc = slice_end(c, &ev);
+            break;
+        case EV_BALANCE:
+            rc = push_balance(c);
+            break;
+        }
+        if (rc != 0) return -1;
+
+        if (calq_peek(&c->events, &next) == 0 && next.time <= c->now) continue;
+        for (int k = 0; k < c->cfg.ncpu; k++)
+            if (c->cpu[k].running < 0 && dispatch(c, k) != 0) return -1;
+    }
+    return 0;
+}
+
+/* Plain FCFS on one CPU takes the parallel scan, which gives the same results. */
+int sched_run(struct sched_ctx *c) {
+    struct timespec start_t, end_t;
+    clock_gettime(CLOCK_MONOTONIC, &start_t);
+
+    int rc = fcfs_scan_applies(c) ? fcfs_scan(c) : event_loop(c);
+    if (rc != 0) return -1;
+    sched_aggregate(c);
+
+    clock_gettime(CLOCK_MONOTONIC, &end_t);
+    c->stats.exec_time = elapsed_sec(&start_t, &end_t);
+    return 0;
+}
+
+// ================= REPORTING =================
+
+static void print_row(const struct sched_ctx *c, int i, int with_priority) {
+    const struct workload *wl = c->wl;
+    const struct proc_table *p = &c->p;
+
+    if (with_priority)
+        printf("| %-4d | %-5.1f | %-5.1f | %-8d | %-8.2f | %-8.2f | %-8.2f | %-8.2f | %-8.2f |\n",
+               wl->pid[i], wl->at[i], wl->bt[i], wl->priority[i], p->st[i], p->ft[i],
+               p->wt[i], p->tat[i], p->rt[i]);
+    else
+        printf("| %-4d | %-5.1f | %-5.1f | %-9.2f | %-9.2f | %-9.2f | %-9.2f | %-9.2f |\n",
+               wl->pid[i], wl->at[i], wl->bt[i], p->st[i], p->ft[i],
+               p->wt[i], p->tat[i], p->rt[i]);
+}
+
+void sched_print_table(const struct sched_ctx *c, enum sched_table_order order,
+                       int with_priority) {
+    const char *rule = with_priority
+        ? "+------+-------+-------+----------+----------+----------+----------+----------+----------+\n"
+        : "+------+-------+-------+-----------+-----------+-----------+-----------+-----------+\n";
+
+    if (c->wl->n > SCHED_TABLE_LIMIT) {
+        printf("\n(Per-process table omitted for %d processes)\n", c->wl->n);
+        return;
+    }
+
+    printf("\n%s", rule);
+    if (with_priority)
+        printf("| PID  |   AT  |   BT  | Priority |  Start   |  Finish  |   WT     |   TAT    |   RT     |\n");
+    else
+        printf("| PID  |   AT  |   BT  |  Start    |  Finish   |   WT      |   TAT     |   RT      |\n");
+    printf("%s", rule);
+
+    for (int k = 0; k < c->completed; k++)
+        print_row(c, order == SCHED_ORDER_PID ? k : c->done_order[k], with_priority);
+
+    printf("%s", rule);
+}
+
+/* Swap traffic and stalls of the working-set model; a large stall share means thrashing. */
+static void sched_print_memory(const struct sched_ctx *c) {
+    const struct sched_stats *s = &c->stats;
+    const struct sched_mem *m = c->mem;
+
+    printf("Physical Memory            : %.1f MB (peak demand %.1f MB)\n", m->total, m->peak_demand);
+    printf("Swap-Outs                  : %ld (%.1f MB)\n", m->swap_outs, m->out_mb);
+    printf("Swap-Ins                   : %ld (%.1f MB)\n", m->swap_ins, m->in_mb);
+    printf("Stalled Dispatches         : %d\n", s->total_swaps);
+    printf("Memory Stall Time          : %.6f units (%.2f%% of CPU time)\n", s->swap_stall,
+           s->swap_stall / (s->swap_stall + s->total_bt) * 100);
+    if (m->overcommit > 0)
+        printf("Overcommitted              : %.1f MB (jobs larger than free memory)\n", m->overcommit);
+}
+
+void sched_print_metrics(const struct sched_ctx *c) {
+    const struct sched_stats *s = &c->stats;
+    int n = c->wl->n;
+
+    printf("\nPerformance Metrics:\n");
+    printf("=================================\n");
+    printf("Average Waiting Time       : %.2f units\n", s->total_wt / n);
+    printf("Average Turnaround Time    : %.2f units\n", s->total_tat / n);
+    printf("Average Response Time      : %.2f units\n", s->total_rt / n);
+    printf("Maximum Waiting Time       : %.2f units\n", s->max_wt);
+    printf("Minimum Waiting Time       : %.2f units\n", s->min_wt);
+    printf("Maximum Turnaround Time    : %.2f units\n", s->max_tat);
+    printf("Minimum Turnaround Time    : %.2f units\n", s->min_tat);
+    printf("Throughput                 : %.4f processes/unit\n", (double)n / s->max_ft);
+    printf("CPU Utilization            : %.2f%%\n", (s->total_bt / (s->max_ft * c->cfg.ncpu)) * 100);
+    printf("Total Dispatches           : %ld\n", s->dispatches);
+    printf("Total Preemptions          : %ld\n", s->preemptions);
+    printf("Max Preemptions (one job)  : %d\n", s->max_preempted);
+    if (c->cfg.switch_cost > 0) {
+        printf("Context Switch Cost        : %.9f units\n", c->cfg.switch_cost);
+        printf("Context Switch Overhead    : %.9f units (%ld switches)\n", s->switch_overhead, s->switches);
+    }
+    sched_print_percentiles(c->hist);
+
+    printf("\nSwapping Metrics:\n");
+    printf("=================================\n");
+    if (c->mem) {
+        sched_print_memory(c);
+    } else {
+        printf("Swap Time (per process)    : %.6f units\n", c->cfg.swap_time);
+        printf("Total Swapped Processes   : %d\n", s->total_swaps);
+        printf("Total Swapping Overhead   : %.6f units\n", s->total_swaps * c->cfg.swap_time);
+    }
+
+    printf("\nReal-Time Execution Metrics:\n");
+    printf("=================================\n");
+    printf("Program Execution Time     : %.6f seconds\n", s->exec_time);
+    printf("Scheduling Latency         : %.6f seconds (avg)\n", s->sched_latency / n);
+    printf("Average Process Latency    : %.2f units\n", s->total_wt / n);
+    printf("Total Latency              : %.2f units\n", s->total_wt);
+    printf("Worst-Case Latency         : %.2f units\n", s->max_wt);
+}
+
+/* Tail percentiles of WT, TAT and RT from the streaming histograms. */
+void sched_print_percentiles(const struct sched_hist *hist) {
+    static const char *names[SCHED_METRICS] = { "WT", "TAT", "RT" };
+    static const double q[] = { 0.50, 0.95, 0.99, 0.999 };
+
+    printf("\nPercentiles (streaming, within 0.4%%):\n");
+    printf("+--------+------------+------------+------------+------------+\n");
+    printf("| Metric |    P50     |    P95     |    P99     |   P99.9    |\n");
+    printf("+--------+------------+------------+------------+------------+\n");
+    for (int m = 0; m < SCHED_METRICS; m++) {
+        printf("| %-6s |", names[m]);
+        for (size_t i = 0; i < sizeof(q) / sizeof(q[0]); i++)
+            printf(" %-10.2f |", hist_quantile(&hist[m], q[i]));
+        printf("\n");
+    }
+    printf("+--------+------------+------------+------------+------------+\n");
+}
+
+/* Waiting time per priority class, to show whether low classes starve. */
+void sched_print_priority_classes(const struct sched_ctx *c) {
+    int levels = c->cfg.prio_levels;
+    long *count = calloc(levels, sizeof(long));
+    double *sum = calloc(levels, sizeof(double));
+    double *worst = calloc(levels, sizeof(double));
+
+    if (!count || !sum || !worst) goto out;
+
+    for (int i = 0; i < c->wl->n; i++) {
+        int l = c->wl->priority[i];
+        if (l < 0) l = 0;
+        if (l >= levels) l = levels - 1;
+        count[l]++;
+        sum[l] += c->p.wt[i];
+        if (c->p.wt[i] > worst[l]) worst[l] = c->p.wt[i];
+    }
+
+    printf("\nStarvation Metrics (by Priority Class):\n");
+    printf("+----------+------------+--------------+--------------+\n");
+    printf("| Priority |   Jobs     |   Avg WT     |   Max WT     |\n");
+    printf("+----------+------------+--------------+--------------+\n");
+    for (int l = 0; l < levels; l++)
+        if (count[l])
+            printf("| %-8d | %-10ld | %-12.2f | %-12.2f |\n", l, count[l], sum[l] / count[l], worst[l]);
+    printf("+----------+------------+--------------+--------------+\n");
+    printf("Aging Rate                 : %.4f levels/unit\n", c->cfg.aging_rate);
+    printf("Aged Dispatches            : %ld\n", c->stats.aged_dispatches);
+
+out:
+    free(count);
+    free(sum);
+    free(worst);
+}
+
+/* Per-CPU load and how evenly the balancer spread it. */
+void sched_print_cpus(const struct sched_ctx *c) {
+    const struct sched_stats *s = &c->stats;
+    double lo = DBL_MAX, hi = 0;
+
+    printf("\nSMP Metrics (%d CPUs, %s balancing):\n", c->cfg.ncpu, sched_balance_names[c->cfg.balance]);
+    printf("+------+--------------+----------+--------------+------------+-----------+\n");
+    printf("| CPU  |  Busy Time   |  Util    |  Dispatches  | Migrated In| Max Queue |\n");
+    printf("+------+--------------+----------+--------------+------------+-----------+\n");
+    for (int k = 0; k < c->cfg.ncpu; k++) {
+        const struct sched_cpu *cpu = &c->cpu[k];
+        double util = cpu->busy / s->max_ft * 100;
+        if (util < lo) lo = util;
+        if (util > hi) hi = util;
+        if (k < SCHED_TABLE_LIMIT)
+            printf("| %-4d | %-12.2f | %6.2f%%  | %-12ld | %-10ld | %-9d |\n",
+                   k, cpu->busy, util, cpu->dispatches, cpu->migrations, cpu->max_queued);
+    }
+    printf("+------+--------------+----------+--------------+------------+-----------+\n");
+    printf("Total Migrations           : %ld\n", s->migrations);
+    printf("Utilization Spread         : %.2f%% (busiest - idlest CPU)\n", hi - lo);
+    printf("Avg Load Imbalance         : %.2f jobs (busiest - idlest, time-averaged)\n",
+           s->load_imbalance / s->max_ft);
+}
@@ -0,0 +1,217 @@
+#ifndef SCHED_ENGINE_H
+#define SCHED_ENGINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "sched_calib.h"
+#include "sched_event.h"
+#include "sched_hist.h"
+#include "sched_mem.h"
+#include "sched_switch.h"
+#include "sched_trace.h"
+#include "sched_workload.h"
+
+// ================= SIMULATION STATE =================
+
+/*
+ * Per-job state of one simulated run, one column per field. The hot
+ * columns are what the event loop reads and writes while a job is in
+ * the system; results are written once, when the job starts or
+ * finishes, and are only read back by the reports and the aggregation
+ * kernels, so they never share cache lines with the hot state.
+ */
+struct proc_table {
+    // hot
+    double *rem;
+    double *ready;          // when it last joined a run queue
+    unsigned char *started;
+    int *preempted;
+    double *switch_base;    // its CPU's switch charges when it arrived (rebased on migration)
+
+    // cold
+    double *st, *ft, *wt, *tat, *rt;
+};
+
+struct sched_stats {
+    double total_wt, total_tat, total_rt, total_bt;
+    double max_wt, min_wt, max_tat, min_tat;
+    double max_ft;
+    double sched_latency;
+    double exec_time;
+    long dispatches;
+    long preemptions;
+    int max_preempted;
+    long aged_dispatches;
+    long switches;          // preemptions that handed the CPU to another job
+    double switch_overhead; // time those switches cost
+    int total_swaps;        // dispatches that waited on swap
+    double swap_stall;      // time those dispatches waited
+    long migrations;
+    double load_imbalance;  // time integral of busiest minus idlest CPU load
+};
+
+/* Per-job result distributions, streamed into one histogram each. */
+enum sched_metric { METRIC_WT, METRIC_TAT, METRIC_RT, SCHED_METRICS };
+
+/*
+ * How an SMP run spreads jobs over the per-CPU run queues. All but P2C
+ * deal arrivals round-robin; PUSH and STEAL then move queued jobs.
+ */
+enum sched_balance {
+    SCHED_BALANCE_NONE,     // jobs stay where they were placed
+    SCHED_BALANCE_PUSH,     // every balance_interval, busiest queue pushes to idlest
+    SCHED_BALANCE_STEAL,    // a CPU that runs dry takes a job from the longest queue
+    SCHED_BALANCE_P2C,      // arrivals join the less loaded of two random CPUs
+};
+
+extern const char *const sched_balance_names[];
+
+/* Run parameters; zero fields take the defaults below. */
+struct sched_config {
+    double quantum;
+    double swap_time;           // legacy: flat cost after waiting SCHED_SWAP_WAIT (switch charges excluded)
+    double mem_mb;              // physical memory for jobs, 0 = legacy swap rule
+    double job_mem_mb;          // footprint of jobs without a mem column
+    struct swap_model swap_dev; // swap device, all zero = calibrate this disk
+    double switch_cost;         // charged when a preempted job's CPU runs another job
+    int prio_levels;
+    double aging_rate;      // priority levels gained per time unit waiting
+    int prio_preempt;       // arrivals may preempt a lower-priority job
+    int mlfq_levels;
+    double mlfq_quantum[16];    // 0 = quantum * 2^level
+    double mlfq_boost;          // boost everything to the top level this often, 0 = never
+    double cfs_latency;         // target latency: every runnable job runs once per period
+    double cfs_min_gran;        // shortest slice, stretches the period when crowded
+    double cfs_wakeup_gran;     // vruntime lead an arrival needs to preempt
+    int ncpu;                   // simulated CPUs, one run queue each
+    enum sched_balance balance;
+    double balance_interval;
+    uint64_t seed;              // random placement choices, 0 = fixed default
+    int threads;                // arrival sort and FCFS scan workers, 0 = one per online CPU,
+                                // -1 = keep FCFS on the event loop
+};
+
+#define SCHED_PRIO_LEVELS 140
+#define SCHED_MLFQ_LEVELS 3
+#define SCHED_MLFQ_MAX_LEVELS 16
+#define SCHED_DEFAULT_QUANTUM 2.0
+#define SCHED_CFS_LATENCY 6.0
+#define SCHED_CFS_MIN_GRAN 0.75
+#define SCHED_CFS_WAKEUP_GRAN 1.0
+#define SCHED_MAX_CPUS 4096
+#define SCHED_BALANCE_INTERVAL 4.0
+
+struct sched_ctx;
+struct sched_incr;
+
+/*
+ * A scheduling policy owns the ready queue. The engine admits jobs in
+ * arrival order through enqueue() (non-zero on allocation failure), asks
+ * pick() for the next job to run (-1 when nothing is ready) and slice()
+ * for how long it may run. Queues are sized in init() or grow to their
+ * high-water mark, so a steady-state run never touches the allocator.
+ * Preemptive policies also set preempts(), asked right after an arrival
+ * is enqueued whether it should take the CPU from the running job.
+ *
+ * With several CPUs a policy keeps one run queue per CPU and every hook
+ * acts on queue c->rq. Per-job state is shared by all queues, since a
+ * job is queued on at most one. Balancing moves a job by pick() on one
+ * queue and enqueue() on another, so pick() sets c->pick_aged and the
+ * engine counts an aged dispatch only when the job is dispatched.
+ */
+struct sched_policy {
+    const char *name;
+    int    (*init)(struct sched_ctx *c);
+    void   (*destroy)(struct sched_ctx *c);
+    int    (*enqueue)(struct sched_ctx *c, int idx);
+    int    (*pick)(struct sched_ctx *c);
+    double (*slice)(struct sched_ctx *c, int idx);
+    int    (*preempts)(struct sched_ctx *c, int running, int idx);
+};
+
+extern const struct sched_policy sched_fcfs;
+extern const struct sched_policy sched_sjf;
+extern const struct sched_policy sched_srtf;
+extern const struct sched_policy sched_rr;
+extern const struct sched_policy sched_ps;
+extern const struct sched_policy sched_mlfq;
+extern const struct sched_policy sched_cfs;
+
+/* NULL-terminated list of every policy, and lookup by case-insensitive name. */
+extern const struct sched_policy *const sched_policies[];
+const struct sched_policy *sched_policy_by_name(const char *name);
+
+/* What one simulated CPU is doing between events, and its totals. */
+struct sched_cpu {
+    int running;        // job index, -1 when idle
+    double start, len;  // current slice, after any switch and swap-in
+    int preempted;      // job just preempted here, -1 if none
+    unsigned gen;
+    int nr_queued;
+    int max_queued;
+    double busy;        // burst time executed here
+    double switched;    // switch charges paid here so far
+    long dispatches;
+    long migrations;    // jobs moved onto this CPU
+};
+
+struct sched_ctx {
+    const struct workload *wl;
+    const struct sched_policy *policy;
+    void *pdata;
+
+    struct proc_table p;
+    int *by_arrival;
+    int next_arrival;
+    int *done_order;
+    int completed;
+
+    double now;
+    struct calq events;
+    struct sched_cpu *cpu;  // cfg.ncpu entries
+    int rq;                 // CPU whose run queue the policy hooks act on
+    int nr_queued;          // over all run queues
+    int next_cpu;           // round-robin placement cursor
+    int balance_armed;
+    int pick_aged;          // set by pick() when aging chose over a higher level
+    uint64_t rng;
+    struct sched_config cfg;
+    struct sched_stats stats;
+    struct sched_hist *hist;    // SCHED_METRICS entries, fixed size whatever n is
+    struct sched_mem *mem;      // working-set model, NULL with cfg.mem_mb == 0
+
+    /* Optional per-slice observer, called after any swap-in penalty. */
+    void (*on_slice)(struct sched_ctx *c, int idx, double len);
+    /* Optional binary event log, owned by the caller (trace_open/trace_close). */
+    struct sched_trace *trace;
+    /* Checkpoints for sched_edit(), built by the first edit. */
+    struct sched_incr *incr;
+};
+
+#define SCHED_SWAP_WAIT 5.0
+#define SCHED_TABLE_LIMIT 100
+
+int  sched_init(struct sched_ctx *c, const struct workload *wl,
+                const struct sched_policy *policy, const struct sched_config *cfg);
+int  sched_run(struct sched_ctx *c);
+double sched_running_rem(const struct sched_ctx *c);
+void sched_aggregate(struct sched_ctx *c);
+void sched_free(struct sched_ctx *c);
+int  sched_log_open(struct sched_ctx *c, const char *path);
+void sched_log_close(struct sched_ctx *c, const char *path);
+
+// ================= REPORTING =================
+
+enum sched_table_order { SCHED_ORDER_COMPLETION, SCHED_ORDER_PID };
+
+void sched_print_table(const struct sched_ctx *c, enum sched_table_order order,
+                       int with_priority);
+void sched_print_metrics(const struct sched_ctx *c);
+void sched_print_percentiles(const struct sched_hist *hist);
+void sched_print_priority_classes(const struct sched_ctx *c);
+void sched_print_cpus(const struct sched_ctx *c);
+
+#endif
@@ -0,0 +1,196 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sched_event.h"
+
+// ================= CALENDAR QUEUE =================
+
+#define CALQ_MIN_BUCKETS 16
+#define CALQ_SAMPLE 64
+
+static inline int ev_less(const struct sched_event *a, const struct sched_event *b) {
+    if (a->time != b->time) return a->time < b->time;
+    if (a->type != b->type) return a->type < b->type;
+    return a->seq < b->seq;
+}
+
+/*
+ * Events are filed by integer day so the scan never depends on comparing
+ * a time against a rounded bucket boundary.
+ */
+static inline int64_t day_of(const struct calq *q, double t) {
+    return (int64_t)floor(t / q->width);
+}
+
+static inline int bucket_of(const struct calq *q, int64_t day) {
+    return (int)(day & (q->nbuckets - 1));
+}
+
+static void set_cursor(struct calq *q, double t) {
+    q->last_time = t;
+    q->cur_day = day_of(q, t);
+}
+
+static int alloc_buckets(struct calq *q, int nbuckets) {
+    int *b = malloc((size_t)nbuckets * sizeof(int));
+    if (!b) return -1;
+    for (int i = 0; i < nbuckets; i++) b[i] = -1;
+    free(q->bucket);
+    q->bucket = b;
+    q->nbuckets = nbuckets;
+    return 0;
+}
+
+int calq_init(struct calq *q) {
+    memset(q, 0, sizeof(*q));
+    q->width = 1.0;
+    q->free_head = -1;
+    if (alloc_buckets(q, CALQ_MIN_BUCKETS) != 0) return -1;
+    set_cursor(q, 0.0);
+    return 0;
+}
+
+void calq_free(struct calq *q) {
+    free(q->pool);
+    free(q->bucket);
+    memset(q, 0, sizeof(*q));
+}
+
+static void insert_node(struct calq *q, int node) {
+    q->pool[node].day = day_of(q, q->pool[node].ev.time);
+    int *link = &q->bucket[bucket_of(q, q->pool[node].day)];
+    while (*link >= 0 && !ev_less(&q->pool[node].ev, &q->pool[*link].ev))
+        link = &q->pool[*link].next;
+    q->pool[node].next = *link;
+    *link = node;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * Width from a spread sample of pending events: three times the median
+ * gap between sampled neighbours, scaled back to the full event count.
+ * The median keeps a few far-future events from flattening the calendar.
+ */
+static double estimate_width(const struct calq *q) {
+    double sample[CALQ_SAMPLE];
+    int step = q->size / CALQ_SAMPLE + 1, k = 0, seen = 0;
+
+    for (int b = 0; b < q->nbuckets && k < CALQ_SAMPLE; b++)
+        for (int i = q->bucket[b]; i >= 0 && k < CALQ_SAMPLE; i = q->pool[i].next)
+            if (seen++ % step == 0) sample[k++] = q->pool[i].ev.time;
+    if (k < 2) return q->width;
+
+    qsort(sample, k, sizeof(double), cmp_double);
+    double gaps[CALQ_SAMPLE];
+    int g = 0;
+    for (int i = 1; i < k; i++)
+        if (sample[i] > sample[i - 1]) gaps[g++] = sample[i] - sample[i - 1];
+    if (g == 0) return q->width;
+
+    qsort(gaps, g, sizeof(double), cmp_double);
+    double w = 3.0 * gaps[g / 2] * k / q->size;
+    return (w > sample[k - 1] * 1e-12 && w > 0) ? w : q->width;
+}
+
+/* Rebuild with a new bucket count and a freshly estimated day width. */
+static void resize(struct calq *q, int nbuckets) {
+    int *old = q->bucket;
+    int old_n = q->nbuckets;
+    double width = estimate_width(q);
+
+    q->bucket = NULL;
+    if (alloc_buckets(q, nbuckets) != 0) {
+        q->bucket = old;
+        q->nbuckets = old_n;
+        return;
+    }
+    q->width = width;
+
+    for (int b = 0; b < old_n; b++) {
+        int i = old[b];
+        while (i >= 0) {
+            int next = q->pool[i].next;
+            insert_node(q, i);
+            i = next;
+        }
+    }
+    free(old);
+    set_cursor(q, q->last_time);
+}
+
+int calq_push(struct calq *q, const struct sched_event *ev) {
+    if (q->free_head < 0) {
+        int cap = q->pool_cap ? q->pool_cap * 2 : 64;
+        struct cal_node *pool = realloc(q->pool, (size_t)cap * sizeof(*pool));
+        if (!pool) return -1;
+        for (int i = q->pool_cap; i < cap; i++) pool[i].next = (i + 1 < cap) ? i + 1 : -1;
+        q->pool = pool;
+        q->free_head = q->pool_cap;
+        q->pool_cap = cap;
+    }
+
+    int node = q->free_head;
+    q->free_head = q->pool[node].next;
+    q->pool[node].ev = *ev;
+    q->pool[node].ev.seq = q->seq++;
+    insert_node(q, node);
+
+    if (ev->time < q->last_time) set_cursor(q, ev->time);
+    if (++q->size > 2 * q->nbuckets) resize(q, q->nbuckets * 2);
+    return 0;
+}
+
+/* Locate the earliest event without moving the cursor. */
+static int find_min(const struct calq *q, int *bucket_out) {
+    if (q->size == 0) return -1;
+
+    for (int k = 0; k < q->nbuckets; k++) {
+        int b = bucket_of(q, q->cur_day + k);
+        int head = q->bucket[b];
+        if (head >= 0 && q->pool[head].day <= q->cur_day + k) {
+            *bucket_out = b;
+            return head;
+        }
+    }
+
+    // Nothing within a year of the cursor: direct search of bucket heads
+    int best = -1;
+    for (int b = 0; b < q->nbuckets; b++) {
+        int head = q->bucket[b];
+        if (head >= 0 && (best < 0 || ev_less(&q->pool[head].ev, &q->pool[best].ev))) {
+            best = head;
+            *bucket_out = b;
+        }
+    }
+    return best;
+}
+
+int calq_peek(const struct calq *q, struct sched_event *out) {
+    int b;
+    int node = find_min(q, &b);
+    if (node < 0) return -1;
+    *out = q->pool[node].ev;
+    return 0;
+}
+
+int calq_pop(struct calq *q, struct sched_event *out) {
+    int b;
+    int node = find_min(q, &b);
+    if (node < 0) return -1;
+
+    *out = q->pool[node].ev;
+    q->cur_day = q->pool[node].day;
+    q->last_time = out->time;
+    q->bucket[b] = q->pool[node].next;
+    q->pool[node].next = q->free_head;
+    q->free_head = node;
+
+    if (--q->size < q->nbuckets / 2 && q->nbuckets > CALQ_MIN_BUCKETS)
+        resize(q, q->nbuckets / 2);
+    return 0;
+}
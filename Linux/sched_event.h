@@ -0,0 +1,62 @@
+#ifndef SCHED_EVENT_H
+#define SCHED_EVENT_H
+
+#include <stdint.h>
+
+// ================= SIMULATION EVENTS =================
+
+/* Events at the same time fire in this order. */
+enum sched_event_type {
+    EV_ARRIVAL,
+    EV_SLICE_END,
+    EV_BALANCE,
+};
+
+struct sched_event {
+    double time;
+    int type;
+    int idx;
+    int cpu;
+    unsigned gen;      // slice generation; stale slice ends are skipped
+    uint64_t seq;      // insertion order, breaks remaining ties
+};
+
+// ================= CALENDAR QUEUE =================
+
+/*
+ * Brown's calendar queue: a ring of day-buckets of fixed width, each a
+ * sorted list, scanned one "year" at a time. The bucket count doubles or
+ * halves with the event count and the width is re-estimated from the
+ * spread of pending events, so push and pop stay O(1) amortized however
+ * far apart in time the events are. Nodes come from a growable pool.
+ */
+struct cal_node {
+    struct sched_event ev;
+    int64_t day;
+    int next;
+};
+
+struct calq {
+    struct cal_node *pool;
+    int pool_cap;
+    int free_head;
+
+    int *bucket;
+    int nbuckets;
+    double width;
+
+    int size;
+    int64_t cur_day;
+    double last_time;
+    uint64_t seq;
+};
+
+int  calq_init(struct calq *q);
+void calq_free(struct calq *q);
+int  calq_push(struct calq *q, const struct sched_event *ev);
+int  calq_pop(struct calq *q, struct sched_event *out);
+int  calq_peek(const struct calq *q, struct sched_event *out);
+
+static inline int calq_empty(const struct calq *q) { return q->size == 0; }
+
+#endif
@@ -0,0 +1,53 @@
+#include <stdlib.h>
+
+#include "sched_engine.h"
+#include "sched_queue.h"
+
+// ================= FCFS POLICY =================
+
+/* Jobs are admitted in arrival order, so a plain FIFO per CPU is FCFS. */
+#define FCFS_INITIAL_CAP 1024
+
+static void fcfs_destroy(struct sched_ctx *c) {
+    struct fifo *q = c->pdata;
+    if (!q) return;
+    for (int k = 0; k < c->cfg.ncpu; k++) fifo_free(&q[k]);
+    free(q);
+}
+
+static int fcfs_init(struct sched_ctx *c) {
+    struct fifo *q = calloc(c->cfg.ncpu, sizeof(*q));
+    if (!q) return -1;
+    c->pdata = q;
+    for (int k = 0; k < c->cfg.ncpu; k++) {
+        if (fifo_init(&q[k], FCFS_INITIAL_CAP) != 0) {
+            fcfs_destroy(c);
+            c->pdata = NULL;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int fcfs_enqueue(struct sched_ctx *c, int idx) {
+    struct fifo *q = c->pdata;
+    return fifo_push(&q[c->rq], idx);
+}
+
+static int fcfs_pick(struct sched_ctx *c) {
+    struct fifo *q = c->pdata;
+    return fifo_pop(&q[c->rq]);
+}
+
+static double fcfs_slice(struct sched_ctx *c, int idx) {
+    return c->p.rem[idx];
+}
+
+const struct sched_policy sched_fcfs = {
+    .name = "FCFS",
+    .init = fcfs_init,
+    .destroy = fcfs_destroy,
+    .enqueue = fcfs_enqueue,
+    .pick = fcfs_pick,
+    .slice = fcfs_slice,
+};
@@ -0,0 +1,103 @@
+#include <math.h>
+#include <string.h>
+
+#include "sched_hist.h"
+
+// ================= STREAMING QUANTILE HISTOGRAM =================
+
+void hist_reset(struct sched_hist *h) {
+    h->count = h->zero = h->live = 0;
+    h->min = h->max = 0;
+}
+
+/* Bin of v, or NULL when it counts as zero. Rows are cleared on first use. */
+static uint64_t *hist_bin(struct sched_hist *h, double v) {
+    if (!(v > 0)) return NULL;
+
+    int row, sub;
+    if (isinf(v)) {
+        row = HIST_ROWS;            // frexp leaves e unspecified for inf
+        sub = 0;
+    } else {
+        int e;
+        double m = frexp(v, &e);    // v = m * 2^e, m in [0.5, 1)
+        row = e - HIST_MIN_EXP;
+        if (row < 0) return NULL;
+        sub = (int)((m * 2 - 1) * HIST_SUB);
+    }
+    if (row >= HIST_ROWS) {
+        row = HIST_ROWS - 1;
+        sub = HIST_SUB - 1;
+    }
+    if (!(h->live >> row & 1)) {
+        memset(h->bin[row], 0, sizeof(h->bin[row]));
+        h->live |= 1ULL << row;
+    }
+    return &h->bin[row][sub];
+}
+
+void hist_add(struct sched_hist *h, double v) {
+    if (h->count == 0 || v < h->min) h->min = v;
+    if (h->count == 0 || v > h->max) h->max = v;
+    h->count++;
+
+    uint64_t *bin = hist_bin(h, v);
+    if (bin)
+        (*bin)++;
+    else
+        h->zero++;
+}
+
+/* Take back one earlier hist_add(h, v). min and max are left for the caller to reset. */
+void hist_remove(struct sched_hist *h, double v) {
+    h->count--;
+
+    uint64_t *bin = hist_bin(h, v);
+    if (bin)
+        (*bin)--;
+    else
+        h->zero--;
+}
+
+void hist_merge(struct sched_hist *dst, const struct sched_hist *src) {
+    if (src->count == 0) return;
+    if (dst->count == 0 || src->min < dst->min) dst->min = src->min;
+    if (dst->count == 0 || src->max > dst->max) dst->max = src->max;
+    dst->count += src->count;
+    dst->zero += src->zero;
+
+    for (uint64_t rows = src->live; rows; rows &= rows - 1) {
+        int r = __builtin_ctzll(rows);
+        if (!(dst->live >> r & 1)) {
+            memcpy(dst->bin[r], src->bin[r], sizeof(dst->bin[r]));
+            dst->live |= 1ULL << r;
+            continue;
+        }
+        for (int b = 0; b < HIST_SUB; b++) dst->bin[r][b] += src->bin[r][b];
+    }
+}
+
+/* Midpoint of the bin holding the ceil(q * count)-th smallest value, clamped to [min, max]. */
+double hist_quantile(const struct sched_hist *h, double q) {
+    if (h->count == 0) return 0;
+
+    uint64_t rank = (uint64_t)ceil(q * h->count);
+    if (rank < 1) rank = 1;
+    if (rank > h->count) rank = h->count;
+    if (rank <= h->zero) return h->min;
+
+    uint64_t seen = h->zero;
+    for (uint64_t rows = h->live; rows; rows &= rows - 1) {
+        int r = __builtin_ctzll(rows);
+        for (int b = 0; b < HIST_SUB; b++) {
+            seen += h->bin[r][b];
+            if (seen < rank) continue;
+
+            double v = ldexp(0.5 + (b + 0.5) / (2.0 * HIST_SUB), r + HIST_MIN_EXP);
+            if (v < h->min) v = h->min;
+            if (v > h->max) v = h->max;
+            return v;
+        }
+    }
+    return h->max;
+}
@@ -0,0 +1,35 @@
+#ifndef SCHED_HIST_H
+#define SCHED_HIST_H
+
+#include <stdint.h>
+
+// ================= STREAMING QUANTILE HISTOGRAM =================
+
+/*
+ * Log-linear histogram in the style of HdrHistogram. Each power of two
+ * is one row of 2^HIST_SUB_BITS equal-width bins, so any recorded value
+ * is known to within 1/2^(HIST_SUB_BITS+1) (0.4%) of itself, whatever
+ * its magnitude. Memory is fixed at HIST_ROWS rows however many values
+ * are added. Rows are cleared the first time they are touched, so a
+ * reset is O(1), and two histograms merge by adding counts.
+ */
+#define HIST_SUB_BITS 7
+#define HIST_SUB (1 << HIST_SUB_BITS)
+#define HIST_ROWS 64
+#define HIST_MIN_EXP (-16)      // values below 2^-17 count as zero
+
+struct sched_hist {
+    uint64_t count;
+    uint64_t zero;
+    uint64_t live;              // bit r set once row r holds counts
+    double min, max;
+    uint64_t bin[HIST_ROWS][HIST_SUB];
+};
+
+void   hist_reset(struct sched_hist *h);
+void   hist_add(struct sched_hist *h, double v);
+void   hist_remove(struct sched_hist *h, double v);
+void   hist_merge(struct sched_hist *dst, const struct sched_hist *src);
+double hist_quantile(const struct sched_hist *h, double q);
+
+#endif
@@ -0,0 +1,317 @@
+#define _POSIX_C_SOURCE 199309L
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sched_incr.h"
+#include "sched_simd.h"
+
+// ================= CHECKPOINTS =================
+
+#define INCR_T0 0.0     // the clock every run starts at
+
+int incr_applies(const struct sched_ctx *c) {
+    int nonpreemptive = c->policy == &sched_fcfs || c->policy == &sched_sjf ||
+                        (c->policy == &sched_ps && !c->cfg.prio_preempt && c->cfg.aging_rate <= 0);
+    return nonpreemptive && c->cfg.ncpu == 1 && !c->mem && !c->trace && !c->on_slice &&
+           c->completed == c->wl->n;
+}
+
+void incr_free(struct sched_incr *inc) {
+    if (!inc) return;
+    free(inc->rank);
+    free(inc->fin);
+    free(inc->mark);
+    free(inc->cp);
+    free(inc);
+}
+
+static inline int same_bits(double a, double b) {
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+/* The clock when dispatch k was decided: its job's arrival or the previous finish. */
+static inline double decided_at(const struct sched_ctx *c, int k) {
+    double prev = k ? c->incr->fin[k - 1] : INCR_T0;
+    double at = c->wl->at[c->done_order[k]];
+    return at > prev ? at : prev;
+}
+
+/* First arrival position whose job arrives after t. */
+static int arrived_by(const struct sched_ctx *c, double t, int lo) {
+    int hi = c->wl->n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (c->wl->at[c->by_arrival[mid]] <= t) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+/* First arrival position whose job arrives at or after t. */
+static int arriving_from(const struct sched_ctx *c, double t) {
+    int lo = 0, hi = c->wl->n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (c->wl->at[c->by_arrival[mid]] < t) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+/* Stalls, queue depth and earliest arrival of one segment, as the event loop saw them. */
+static void count_segment(struct sched_ctx *c, int s) {
+    struct incr_cp *cp = &c->incr->cp[s];
+    int n = c->wl->n;
+    int lo = s * INCR_SEGMENT, hi = lo + INCR_SEGMENT < n ? lo + INCR_SEGMENT : n;
+    double swap = c->cfg.swap_time;
+
+    cp->swaps = cp->max_queued = 0;
+    cp->seg_lo = c->wl->at[c->done_order[lo]];
+    int u = arrived_by(c, decided_at(c, lo), 0);
+    for (int k = lo; k < hi; k++) {
+        double at = c->wl->at[c->done_order[k]];
+        double now = decided_at(c, k);
+        if (swap > 0 && (now - at) > SCHED_SWAP_WAIT) cp->swaps++;
+        while (u < n && c->wl->at[c->by_arrival[u]] <= now) u++;
+        if (u - k > cp->max_queued) cp->max_queued = u - k;
+        if (at < cp->seg_lo) cp->seg_lo = at;
+    }
+}
+
+/* Suffix minima from segment `from` down, stopping below `stop` once nothing changes. */
+static void carry_lo(struct sched_incr *inc, int from, int stop) {
+    for (int s = from; s >= 0; s--) {
+        double lo = inc->cp[s].seg_lo;
+        if (s + 1 < inc->ncp && inc->cp[s + 1].lo < lo) lo = inc->cp[s + 1].lo;
+        if (s < stop && same_bits(lo, inc->cp[s].lo)) break;
+        inc->cp[s].lo = lo;
+    }
+}
+
+static int incr_build(struct sched_ctx *c) {
+    int n = c->wl->n;
+    struct sched_incr *inc = calloc(1, sizeof(*inc));
+    if (!inc) return -1;
+
+    inc->ncp = (n + INCR_SEGMENT - 1) / INCR_SEGMENT;
+    inc->rank = malloc((size_t)n * sizeof(int));
+    inc->fin = malloc((size_t)n * sizeof(double));
+    inc->mark = calloc((size_t)n, 1);
+    inc->cp = calloc((size_t)inc->ncp, sizeof(*inc->cp));
+    if (!inc->rank || !inc->fin || !inc->mark || !inc->cp) {
+        incr_free(inc);
+        return -1;
+    }
+    for (int k = 0; k < n; k++) {
+        inc->rank[c->done_order[k]] = k;
+        inc->fin[k] = c->p.ft[c->done_order[k]];
+    }
+    c->incr = inc;
+    for (int s = 0; s < inc->ncp; s++) count_segment(c, s);
+    carry_lo(inc, inc->ncp - 1, 0);
+    return 0;
+}
+
+// ================= EDITS =================
+
+/* Whether job x precedes (at, idx) in the stable arrival order. */
+static inline int arrives_before(const struct sched_ctx *c, int x, double at, int idx) {
+    double ax = c->wl->at[x];
+    return ax < at || (ax == at && x < idx);
+}
+
+/* Write the new arrival and move the job to its place in by_arrival. */
+static void move_arrival(struct sched_ctx *c, struct workload *wl, int idx, double at) {
+    int *ord = c->by_arrival;
+    int lo = 0, hi = wl->n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (arrives_before(c, ord[mid], wl->at[idx], idx)) lo = mid + 1; else hi = mid;
+    }
+    int from = lo;
+
+    // Count the job itself at its old arrival; it moves out of the way below
+    lo = 0;
+    hi = wl->n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (arrives_before(c, ord[mid], at, idx)) lo = mid + 1; else hi = mid;
+    }
+    if (lo > from) {
+        memmove(ord + from, ord + from + 1, (size_t)(lo - 1 - from) * sizeof(int));
+        ord[lo - 1] = idx;
+    } else {
+        memmove(ord + lo + 1, ord + lo, (size_t)(from - lo) * sizeof(int));
+        ord[lo] = idx;
+    }
+    wl->at[idx] = at;
+}
+
+static inline void mark_run(struct sched_incr *inc, int x, int delta, int *diff) {
+    int before = inc->mark[x] != 0;
+    inc->mark[x] += delta;
+    *diff += (inc->mark[x] != 0) - before;
+}
+
+static int admit(struct sched_ctx *c, int *cursor, double now, int *queued) {
+    while (*cursor < c->wl->n && c->wl->at[c->by_arrival[*cursor]] <= now) {
+        if (c->policy->enqueue(c, c->by_arrival[(*cursor)++]) != 0) return -1;
+        (*queued)++;
+    }
+    return 0;
+}
+
+/*
+ * Dispatches from `from` on, with the ready queue rebuilt as it stood
+ * when the CPU freed after dispatch from - 1. Returns where the new
+ * schedule met the old one again (n if it never did), or -1.
+ */
+static int resimulate(struct sched_ctx *c, int idx, int from) {
+    struct sched_incr *inc = c->incr;
+    struct proc_table *p = &c->p;
+    const double *at = c->wl->at, *bt = c->wl->bt;
+    int n = c->wl->n, queued = 0, diff = 0, edited_run = 0;
+    double swap = c->cfg.swap_time;
+    double now = from ? inc->fin[from - 1] : INCR_T0;
+
+    // Everything that arrived by now and had not run: from the checkpoint's low mark on
+    double lo = inc->cp[from / INCR_SEGMENT].lo;
+    if (at[idx] < lo) lo = at[idx];
+    int cursor = arrived_by(c, now, 0);
+    c->rq = 0;
+    for (int pos = arriving_from(c, lo); pos < cursor; pos++) {
+        int x = c->by_arrival[pos];
+        if (inc->rank[x] < from) continue;
+        if (c->policy->enqueue(c, x) != 0) return -1;
+        queued++;
+    }
+
+    int k = from;
+    while (k < n) {
+        if (queued == 0) {
+            double next = at[c->by_arrival[cursor]];
+            if (next > now) now = next;
+            if (admit(c, &cursor, now, &queued) != 0) return -1;
+        }
+        int x = c->policy->pick(c);
+        queued--;
+
+        int y = c->done_order[k];
+        double old_fin = inc->fin[k];
+        double start = now;
+        if (swap > 0 && (start - at[x]) > SCHED_SWAP_WAIT) start += swap;
+        double ft = start + bt[x];
+
+        hist_remove(&c->hist[METRIC_WT], p->wt[x]);
+        hist_remove(&c->hist[METRIC_TAT], p->tat[x]);
+        hist_remove(&c->hist[METRIC_RT], p->rt[x]);
+        p->st[x] = start;
+        p->ft[x] = ft;
+        p->rt[x] = start - at[x];
+        p->tat[x] = ft - at[x];
+        p->wt[x] = p->tat[x] - bt[x];
+        hist_add(&c->hist[METRIC_WT], p->wt[x]);
+        hist_add(&c->hist[METRIC_TAT], p->tat[x]);
+        hist_add(&c->hist[METRIC_RT], p->rt[x]);
+
+        inc->rank[x] = k;
+        inc->fin[k] = ft;
+        c->done_order[k++] = x;
+        mark_run(inc, x, +1, &diff);
+        mark_run(inc, y, -1, &diff);
+        if (x == idx) edited_run = 1;
+
+        if (ft > now) now = ft;
+        if (admit(c, &cursor, now, &queued) != 0) return -1;
+
+        // Same finish, same jobs done and the edit behind us: the rest is the cached run
+        if (edited_run && diff == 0 && same_bits(ft, old_fin)) break;
+    }
+    while (queued-- > 0) c->policy->pick(c);
+    return k;
+}
+
+/* A fresh run over the edited workload, for everything the checkpoints cannot follow. */
+static int rerun(struct sched_ctx *c, struct workload *wl) {
+    const struct sched_policy *policy = c->policy;
+    struct sched_config cfg = c->cfg;
+    void (*on_slice)(struct sched_ctx *, int, double) = c->on_slice;
+    struct sched_trace *trace = c->trace;   // the caller's, sched_free leaves it open
+
+    sched_free(c);
+    if (sched_init(c, wl, policy, &cfg) != 0) return -1;
+    c->on_slice = on_slice;
+    c->trace = trace;
+    if (sched_run(c) != 0) return -1;
+    return wl->n;
+}
+
+int sched_edit(struct sched_ctx *c, struct workload *wl, int idx, double at, double bt) {
+    struct timespec s, e;
+    int n = wl->n;
+
+    if (wl != c->wl || idx < 0 || idx >= n || !isfinite(at) || !isfinite(bt) || at < 0 || bt < 0)
+        return -1;
+    if (workload_writable(wl) != 0) return -1;
+    if (!incr_applies(c)) {
+        wl->at[idx] = at;
+        wl->bt[idx] = bt;
+        return rerun(c, wl);
+    }
+    if (same_bits(at, wl->at[idx]) && same_bits(bt, wl->bt[idx])) return 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &s);
+    if (!c->incr && incr_build(c) != 0) return -1;
+    struct sched_incr *inc = c->incr;
+
+    // The first dispatch decided once the job had arrived, under either arrival
+    double first = at < wl->at[idx] ? at : wl->at[idx];
+    int lo = 0, hi = inc->rank[idx];
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (decided_at(c, mid) < first) lo = mid + 1; else hi = mid;
+    }
+    int from = lo;
+
+    move_arrival(c, wl, idx, at);
+    wl->bt[idx] = bt;
+    c->p.ready[idx] = at > INCR_T0 ? at : INCR_T0;
+
+    int to = resimulate(c, idx, from);
+    if (to < 0) {
+        // The queues may be half built: start over from scratch
+        return rerun(c, wl);
+    }
+
+    for (int sg = from / INCR_SEGMENT; sg <= (to - 1) / INCR_SEGMENT; sg++) count_segment(c, sg);
+    carry_lo(inc, (to - 1) / INCR_SEGMENT, from / INCR_SEGMENT);
+
+    struct sched_stats *st = &c->stats;
+    struct sched_cpu *cpu = &c->cpu[0];
+    st->total_swaps = 0;
+    cpu->max_queued = 0;
+    for (int sg = 0; sg < inc->ncp; sg++) {
+        st->total_swaps += inc->cp[sg].swaps;
+        if (inc->cp[sg].max_queued > cpu->max_queued) cpu->max_queued = inc->cp[sg].max_queued;
+    }
+    // One addition per stall, as the event loop accumulates it
+    st->swap_stall = 0;
+    for (int k = 0; k < st->total_swaps; k++) st->swap_stall += c->cfg.swap_time;
+
+    sched_aggregate(c);
+    cpu->busy = st->total_bt;
+    c->now = inc->fin[n - 1];
+
+    struct col_stats rt;
+    col_stats(c->p.rt, (size_t)n, &rt);
+    c->hist[METRIC_WT].min = st->min_wt;
+    c->hist[METRIC_WT].max = st->max_wt;
+    c->hist[METRIC_TAT].min = st->min_tat;
+    c->hist[METRIC_TAT].max = st->max_tat;
+    c->hist[METRIC_RT].min = rt.min;
+    c->hist[METRIC_RT].max = rt.max;
+
+    clock_gettime(CLOCK_MONOTONIC, &e);
+    st->exec_time = elapsed_sec(&s, &e);
+    return to - from;
+}
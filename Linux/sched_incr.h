@@ -0,0 +1,50 @@
+#ifndef SCHED_INCR_H
+#define SCHED_INCR_H
+
+#include "sched_engine.h"
+
+// ================= INCREMENTAL RE-SIMULATION =================
+
+/*
+ * What-if edits to a finished run. On one CPU without the memory model,
+ * FCFS, SJF and Priority without preemption or aging are decided only
+ * at dispatches, and the state at any dispatch follows from the run's
+ * results: the CPU frees at the previous finish time, and the ready
+ * queue holds every job that has arrived by then and not yet run. An
+ * edit to one job's arrival or burst therefore restarts at the first
+ * dispatch that could see the job. It re-simulates until the finish
+ * time and the set of jobs run both match the cached run again.
+ *
+ * Checkpoints every INCR_SEGMENT dispatches bound where the rebuilt
+ * queue can start and carry the per-segment counters, so only the
+ * segments an edit touched are recounted. Other policies and setups
+ * fall back to a full run. Either way the results are the ones a fresh
+ * sched_run() over the edited workload would give.
+ */
+#define INCR_SEGMENT 4096
+
+struct incr_cp {
+    double lo;          // earliest arrival of a job run at or after this checkpoint
+    double seg_lo;      // earliest arrival of a job run in this segment
+    int swaps;          // stalled dispatches in this segment
+    int max_queued;     // deepest ready queue at a dispatch in this segment
+};
+
+struct sched_incr {
+    int *rank;          // dispatch number of every job
+    double *fin;        // finish time of every dispatch, in dispatch order
+    signed char *mark;  // +1 run only by the new schedule so far, -1 only by the old
+    struct incr_cp *cp;
+    int ncp;
+};
+
+/*
+ * Set job idx's arrival and burst (finite, not negative) in wl, the
+ * workload c ran, made writable if it is mapped, and bring c's results
+ * up to date. Returns the number of dispatches simulated again, or -1.
+ */
+int  sched_edit(struct sched_ctx *c, struct workload *wl, int idx, double at, double bt);
+int  incr_applies(const struct sched_ctx *c);
+void incr_free(struct sched_incr *inc);
+
+#endif
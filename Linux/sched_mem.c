@@ -0,0 +1,110 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "sched_mem.h"
+
+// ================= WORKING-SET SWAP MODEL =================
+
+#define MB_BYTES (1024.0 * 1024.0)
+
+int mem_init(struct sched_mem *m, const struct workload *wl, double total_mb,
+             double job_mb, const struct swap_model *dev) {
+    memset(m, 0, sizeof(*m));
+    m->total = m->free = total_mb;
+    m->head = m->tail = -1;
+    m->dev = *dev;
+
+    int n = wl->n;
+    m->mb = malloc((size_t)n * sizeof(double));
+    m->state = calloc((size_t)n, 1);
+    m->prev = malloc((size_t)n * sizeof(int));
+    m->next = malloc((size_t)n * sizeof(int));
+    if (!m->mb || !m->state || !m->prev || !m->next) {
+        mem_free(m);
+        return -1;
+    }
+    for (int i = 0; i < n; i++)
+        m->mb[i] = (wl->mem_mb && wl->mem_mb[i] > 0) ? wl->mem_mb[i] : job_mb;
+    return 0;
+}
+
+void mem_free(struct sched_mem *m) {
+    free(m->mb);
+    free(m->state);
+    free(m->prev);
+    free(m->next);
+    m->mb = NULL;
+    m->state = NULL;
+    m->prev = m->next = NULL;
+}
+
+static void lru_unlink(struct sched_mem *m, int idx) {
+    int p = m->prev[idx], n = m->next[idx];
+    if (p >= 0) m->next[p] = n; else m->head = n;
+    if (n >= 0) m->prev[n] = p; else m->tail = p;
+}
+
+static void lru_append(struct sched_mem *m, int idx) {
+    m->prev[idx] = m->tail;
+    m->next[idx] = -1;
+    if (m->tail >= 0) m->next[m->tail] = idx; else m->head = idx;
+    m->tail = idx;
+}
+
+void mem_arrive(struct sched_mem *m, int idx) {
+    m->demand += m->mb[idx];
+    if (m->demand > m->peak_demand) m->peak_demand = m->demand;
+}
+
+/*
+ * Make job idx resident before it runs and return the stall: its own
+ * swap-in plus whatever had to be swapped out to make room, queued
+ * behind any swap I/O still in flight.
+ */
+double mem_acquire(struct sched_mem *m, int idx, double now) {
+    double need = m->mb[idx];
+
+    if (m->state[idx] == MEM_RESIDENT) {
+        lru_unlink(m, idx);
+        return 0;
+    }
+
+    double out = 0;
+    while (m->free < need && m->head >= 0) {
+        int v = m->head;
+        lru_unlink(m, v);
+        m->state[v] = MEM_SWAPPED;
+        m->free += m->mb[v];
+        out += m->mb[v];
+        m->swap_outs++;
+    }
+    if (m->free < need) m->overcommit += need - (m->free > 0 ? m->free : 0);
+
+    double in = 0;
+    if (m->state[idx] == MEM_SWAPPED) {
+        in = need;
+        m->swap_ins++;
+    }
+    m->free -= need;
+    m->state[idx] = MEM_RESIDENT;
+    m->out_mb += out;
+    m->in_mb += in;
+
+    double io = swap_out_cost(&m->dev, out * MB_BYTES) + swap_in_cost(&m->dev, in * MB_BYTES);
+    if (io <= 0) return 0;
+    double begin = (m->dev_free > now) ? m->dev_free : now;
+    m->dev_free = begin + io;
+    return m->dev_free - now;
+}
+
+/* Job idx left its CPU but is still resident; it becomes the most recent eviction candidate. */
+void mem_release(struct sched_mem *m, int idx) {
+    lru_append(m, idx);
+}
+
+/* Job idx finished on its CPU; its memory is freed. */
+void mem_exit(struct sched_mem *m, int idx) {
+    m->free += m->mb[idx];
+    m->demand -= m->mb[idx];
+    m->state[idx] = MEM_NEW;
+}
@@ -0,0 +1,46 @@
+#ifndef SCHED_MEM_H
+#define SCHED_MEM_H
+
+#include "sched_calib.h"
+#include "sched_workload.h"
+
+// ================= WORKING-SET SWAP MODEL =================
+
+/*
+ * Physical memory shared by every job, in MB. A job needs its whole
+ * footprint (the workload's mem column, or a default) resident to run.
+ * Jobs stay resident between slices until room is needed; then jobs
+ * that are queued but not running are swapped out least recently run
+ * first. A job that was swapped out is swapped back in before its next
+ * slice; a job's first load is not swap traffic. All swap I/O goes
+ * through one device, served in order, so when several CPUs fault at
+ * once they also wait for each other.
+ */
+#define SCHED_JOB_MEM_MB 64.0
+
+enum mem_state { MEM_NEW, MEM_RESIDENT, MEM_SWAPPED };
+
+struct sched_mem {
+    double total, free;     // MB
+    double demand, peak_demand; // footprints of jobs in the system
+    double *mb;             // per job
+    unsigned char *state;
+    int *prev, *next;       // LRU of resident jobs not on a CPU
+    int head, tail;
+    double dev_free;        // swap device busy until
+    struct swap_model dev;
+
+    long swap_outs, swap_ins;
+    double out_mb, in_mb;
+    double overcommit;      // MB a job ran with beyond physical memory
+};
+
+int    mem_init(struct sched_mem *m, const struct workload *wl, double total_mb,
+                double job_mb, const struct swap_model *dev);
+void   mem_free(struct sched_mem *m);
+void   mem_arrive(struct sched_mem *m, int idx);
+double mem_acquire(struct sched_mem *m, int idx, double now);
+void   mem_release(struct sched_mem *m, int idx);
+void   mem_exit(struct sched_mem *m, int idx);
+
+#endif
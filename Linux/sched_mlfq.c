@@ -0,0 +1,129 @@
+#include <math.h>
+#include <stdlib.h>
+
+#include "sched_engine.h"
+#include "sched_queue.h"
+
+// ================= MLFQ POLICY =================
+
+/*
+ * Multi-Level Feedback Queue. New jobs start at level 0; a job that uses
+ * its whole quantum drops one level, a job preempted early keeps its
+ * level. Level l runs only when every level above it is empty and gets
+ * mlfq_quantum[l]. An arrival preempts anything running below level 0.
+ *
+ * Every mlfq_boost time units all jobs go back to level 0. The queued
+ * ones are spliced onto level 0 in O(levels); each job's own level is
+ * tagged with the boost epoch it was set in and reads as 0 once stale.
+ * A boost covers every CPU's queue at once, so levels and epochs are
+ * per job and survive migration.
+ */
+struct mlfq_state {
+    struct prio_rq *q;      // one per CPU, all linked through q[0].next
+    int *level;
+    unsigned *epoch;
+    double *granted;
+    double *expire;         // end of the quantum granted at the last dispatch
+    unsigned cur_epoch;
+    double next_boost;
+};
+
+static inline int job_level(const struct mlfq_state *s, int idx) {
+    return (s->epoch[idx] == s->cur_epoch) ? s->level[idx] : 0;
+}
+
+static void maybe_boost(struct sched_ctx *c, struct mlfq_state *s) {
+    if (c->cfg.mlfq_boost <= 0 || c->now < s->next_boost) return;
+
+    for (int k = 0; k < c->cfg.ncpu; k++) prio_rq_splice_all(&s->q[k], 0);
+    s->cur_epoch++;
+    s->next_boost = (floor(c->now / c->cfg.mlfq_boost) + 1) * c->cfg.mlfq_boost;
+}
+
+static void mlfq_destroy(struct sched_ctx *c) {
+    struct mlfq_state *s = c->pdata;
+    if (!s) return;
+    if (s->q)
+        for (int k = 0; k < c->cfg.ncpu; k++) prio_rq_free(&s->q[k]);
+    free(s->q);
+    free(s->level);
+    free(s->epoch);
+    free(s->granted);
+    free(s->expire);
+    free(s);
+}
+
+static int mlfq_init(struct sched_ctx *c) {
+    int n = c->wl->n;
+    struct mlfq_state *s = calloc(1, sizeof(*s));
+    if (!s) return -1;
+    c->pdata = s;
+
+    s->level = calloc(n, sizeof(int));
+    s->epoch = calloc(n, sizeof(unsigned));
+    s->granted = calloc(n, sizeof(double));
+    s->expire = calloc(n, sizeof(double));
+    int ok = s->level && s->epoch && s->granted && s->expire &&
+             (s->q = calloc(c->cfg.ncpu, sizeof(*s->q))) != NULL &&
+             prio_rq_init(&s->q[0], c->cfg.mlfq_levels, n) == 0;
+    for (int k = 1; ok && k < c->cfg.ncpu; k++)
+        ok = prio_rq_init_shared(&s->q[k], c->cfg.mlfq_levels, &s->q[0]) == 0;
+    if (!ok) {
+        mlfq_destroy(c);
+        c->pdata = NULL;
+        return -1;
+    }
+    s->next_boost = c->cfg.mlfq_boost;
+    return 0;
+}
+
+static int mlfq_enqueue(struct sched_ctx *c, int idx) {
+    struct mlfq_state *s = c->pdata;
+    maybe_boost(c, s);
+
+    int level = job_level(s, idx);
+    if (s->granted[idx] > 0) {
+        // Coming back from the CPU: demote only if the whole quantum was used
+        if (c->now >= s->expire[idx] &&
+            level + 1 < c->cfg.mlfq_levels)
+            level++;
+        s->granted[idx] = 0;
+    }
+    s->level[idx] = level;
+    s->epoch[idx] = s->cur_epoch;
+
+    prio_rq_push(&s->q[c->rq], level, idx);
+    return 0;
+}
+
+static int mlfq_pick(struct sched_ctx *c) {
+    struct mlfq_state *s = c->pdata;
+    maybe_boost(c, s);
+    return prio_rq_pop(&s->q[c->rq]);
+}
+
+static double mlfq_slice(struct sched_ctx *c, int idx) {
+    struct mlfq_state *s = c->pdata;
+    double q = c->cfg.mlfq_quantum[job_level(s, idx)];
+    double rem = c->p.rem[idx];
+
+    /* Same sum as the slice end's time, so a used-up quantum compares equal. */
+    s->granted[idx] = q;
+    s->expire[idx] = c->cpu[c->rq].start + q;
+    return (rem > q) ? q : rem;
+}
+
+static int mlfq_preempts(struct sched_ctx *c, int running, int idx) {
+    struct mlfq_state *s = c->pdata;
+    return job_level(s, idx) < job_level(s, running);
+}
+
+const struct sched_policy sched_mlfq = {
+    .name = "MLFQ",
+    .init = mlfq_init,
+    .destroy = mlfq_destroy,
+    .enqueue = mlfq_enqueue,
+    .pick = mlfq_pick,
+    .slice = mlfq_slice,
+    .preempts = mlfq_preempts,
+};
@@ -0,0 +1,102 @@
+#include <stdlib.h>
+
+#include "sched_engine.h"
+#include "sched_queue.h"
+
+// ================= PRIORITY POLICY =================
+
+/*
+ * Lowest priority number runs first. Each number maps to one level of a
+ * bitmap run queue (clamped to the configured level count), so a
+ * dispatch is a find-first-set plus a FIFO pop regardless of job count.
+ * Within a level jobs run in arrival order.
+ *
+ * Aging is lazy: a waiting job's effective level is its base level minus
+ * aging_rate * time waited, worked out only at dispatch. The oldest job
+ * of a level is always its head, so only the heads of non-empty levels
+ * need comparing and no waiting job is ever touched on a tick. Waiting
+ * is timed from the engine's ready stamp. A migrated job keeps its
+ * stamp, so it is queued in stamp order rather than at the tail; every
+ * other enqueue is stamped now and lands at the tail anyway.
+ */
+struct ps_state {
+    struct prio_rq *q;      // one per CPU, all linked through q[0].next
+};
+
+static inline int ps_level(const struct sched_ctx *c, int idx) {
+    int prio = c->wl->priority[idx];
+    if (prio < 0) return 0;
+    if (prio >= c->cfg.prio_levels) return c->cfg.prio_levels - 1;
+    return prio;
+}
+
+static void ps_destroy(struct sched_ctx *c) {
+    struct ps_state *s = c->pdata;
+    if (!s) return;
+    if (s->q)
+        for (int k = 0; k < c->cfg.ncpu; k++) prio_rq_free(&s->q[k]);
+    free(s->q);
+    free(s);
+}
+
+static int ps_init(struct sched_ctx *c) {
+    struct ps_state *s = calloc(1, sizeof(*s));
+    if (!s) return -1;
+    c->pdata = s;
+
+    int ok = (s->q = calloc(c->cfg.ncpu, sizeof(*s->q))) != NULL &&
+             prio_rq_init(&s->q[0], c->cfg.prio_levels, c->wl->n) == 0;
+    for (int k = 1; ok && k < c->cfg.ncpu; k++)
+        ok = prio_rq_init_shared(&s->q[k], c->cfg.prio_levels, &s->q[0]) == 0;
+    if (!ok) {
+        ps_destroy(c);
+        c->pdata = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+static int ps_enqueue(struct sched_ctx *c, int idx) {
+    struct ps_state *s = c->pdata;
+    prio_rq_push_ordered(&s->q[c->rq], ps_level(c, idx), idx, c->p.ready);
+    return 0;
+}
+
+static int ps_pick(struct sched_ctx *c) {
+    struct ps_state *s = c->pdata;
+    struct prio_rq *q = &s->q[c->rq];
+    int first = prio_rq_first_level(q);
+    if (first < 0 || c->cfg.aging_rate <= 0) return prio_rq_pop(q);
+
+    int best = first;
+    double best_eff = first - c->cfg.aging_rate * (c->now - c->p.ready[prio_rq_head(q, first)]);
+    for (int l = prio_rq_next_level(q, first + 1); l >= 0; l = prio_rq_next_level(q, l + 1)) {
+        double eff = l - c->cfg.aging_rate * (c->now - c->p.ready[prio_rq_head(q, l)]);
+        if (eff < best_eff) {
+            best = l;
+            best_eff = eff;
+        }
+    }
+
+    c->pick_aged = best != first;
+    return prio_rq_pop_level(q, best);
+}
+
+static double ps_slice(struct sched_ctx *c, int idx) {
+    return c->p.rem[idx];
+}
+
+/* An arrival has waited for nothing, so it competes on its base level. */
+static int ps_preempts(struct sched_ctx *c, int running, int idx) {
+    return c->cfg.prio_preempt && ps_level(c, idx) < ps_level(c, running);
+}
+
+const struct sched_policy sched_ps = {
+    .name = "Priority",
+    .init = ps_init,
+    .destroy = ps_destroy,
+    .enqueue = ps_enqueue,
+    .pick = ps_pick,
+    .slice = ps_slice,
+    .preempts = ps_preempts,
+};
@@ -0,0 +1,477 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "sched_queue.h"
+
+// ================= FIFO RING =================
+
+int fifo_init(struct fifo *q, int cap) {
+    q->buf = malloc((size_t)(cap > 0 ? cap : 1) * sizeof(int));
+    q->cap = cap > 0 ? cap : 1;
+    q->head = q->len = 0;
+    return q->buf ? 0 : -1;
+}
+
+void fifo_free(struct fifo *q) {
+    free(q->buf);
+    q->buf = NULL;
+    q->cap = q->head = q->len = 0;
+}
+
+/* Double the ring and unwrap it so the live entries start at slot 0. */
+int fifo_grow(struct fifo *q) {
+    if (q->cap > 0x3fffffff) return -1;
+
+    int cap = q->cap * 2;
+    int *buf = malloc((size_t)cap * sizeof(int));
+    if (!buf) return -1;
+
+    int first = q->cap - q->head;
+    if (first > q->len) first = q->len;
+    memcpy(buf, q->buf + q->head, (size_t)first * sizeof(int));
+    memcpy(buf + first, q->buf, (size_t)(q->len - first) * sizeof(int));
+
+    free(q->buf);
+    q->buf = buf;
+    q->cap = cap;
+    q->head = 0;
+    return 0;
+}
+
+// ================= JOB BITMAP =================
+
+int bitset_init(struct bitset *b, int nbits) {
+    b->nbits = nbits;
+    b->w = calloc((size_t)(nbits + 63) / 64 + 1, sizeof(uint64_t));
+    return b->w ? 0 : -1;
+}
+
+void bitset_free(struct bitset *b) {
+    free(b->w);
+    b->w = NULL;
+    b->nbits = 0;
+}
+
+// ================= BINARY MIN-HEAP =================
+
+static inline int node_less(const struct heap_node *a, const struct heap_node *b) {
+    return a->key < b->key || (a->key == b->key && a->idx < b->idx);
+}
+
+int heap_init(struct heap *h, int cap) {
+    h->cap = cap > 0 ? cap : 1;
+    h->len = 0;
+    h->node = malloc((size_t)h->cap * sizeof(*h->node));
+    return h->node ? 0 : -1;
+}
+
+void heap_free(struct heap *h) {
+    free(h->node);
+    h->node = NULL;
+    h->cap = h->len = 0;
+}
+
+int heap_push(struct heap *h, double key, int idx) {
+    if (h->len == h->cap) {
+        if (h->cap > 0x3fffffff) return -1;
+        struct heap_node *node = realloc(h->node, (size_t)h->cap * 2 * sizeof(*node));
+        if (!node) return -1;
+        h->node = node;
+        h->cap *= 2;
+    }
+
+    struct heap_node x = { key, idx };
+    int i = h->len++;
+
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!node_less(&x, &h->node[parent])) break;
+        h->node[i] = h->node[parent];
+        i = parent;
+    }
+    h->node[i] = x;
+    return 0;
+}
+
+int heap_pop(struct heap *h) {
+    if (h->len == 0) return -1;
+
+    int top = h->node[0].idx;
+    struct heap_node x = h->node[--h->len];
+    int i = 0, n = h->len;
+
+    // Sift the last node down from the root
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= n) break;
+        if (child + 1 < n && node_less(&h->node[child + 1], &h->node[child])) child++;
+        if (!node_less(&h->node[child], &x)) break;
+        h->node[i] = h->node[child];
+        i = child;
+    }
+    if (n > 0) h->node[i] = x;
+    return top;
+}
+
+// ================= BITMAP PRIORITY RUN QUEUE =================
+
+int prio_rq_init(struct prio_rq *q, int levels, int njobs) {
+    memset(q, 0, sizeof(*q));
+    if (levels <= 0 || levels > PRIO_RQ_MAX_LEVELS) return -1;
+
+    int words = (levels + 63) / 64;
+    q->levels = levels;
+    q->bitmap = calloc(words, sizeof(uint64_t));
+    q->head = malloc((size_t)levels * sizeof(int));
+    q->tail = malloc((size_t)levels * sizeof(int));
+    q->next = malloc((size_t)(njobs > 0 ? njobs : 1) * sizeof(int));
+    if (!q->bitmap || !q->head || !q->tail || !q->next) {
+        prio_rq_free(q);
+        return -1;
+    }
+    for (int l = 0; l < levels; l++) q->head[l] = q->tail[l] = -1;
+    return 0;
+}
+
+/* A queue over the same jobs as links, sharing its next[] array. */
+int prio_rq_init_shared(struct prio_rq *q, int levels, const struct prio_rq *links) {
+    if (prio_rq_init(q, levels, 0) != 0) return -1;
+    free(q->next);
+    q->next = links->next;
+    q->borrowed = 1;
+    return 0;
+}
+
+void prio_rq_free(struct prio_rq *q) {
+    free(q->bitmap);
+    free(q->head);
+    free(q->tail);
+    if (!q->borrowed) free(q->next);
+    memset(q, 0, sizeof(*q));
+}
+
+void prio_rq_push(struct prio_rq *q, int level, int idx) {
+    q->next[idx] = -1;
+    if (q->head[level] < 0) {
+        q->head[level] = idx;
+        q->bitmap[level >> 6] |= 1ULL << (level & 63);
+        q->summary |= 1ULL << (level >> 6);
+    } else {
+        q->next[q->tail[level]] = idx;
+    }
+    q->tail[level] = idx;
+    q->len++;
+}
+
+/* Queue idx behind every job of the level whose key is not above its own. O(1) at the tail. */
+void prio_rq_push_ordered(struct prio_rq *q, int level, int idx, const double *key) {
+    int tail = q->tail[level];
+    if (tail < 0 || key[tail] <= key[idx]) {
+        prio_rq_push(q, level, idx);
+        return;
+    }
+
+    int prev = -1, cur = q->head[level];
+    while (key[cur] <= key[idx]) {
+        prev = cur;
+        cur = q->next[cur];
+    }
+    q->next[idx] = cur;
+    if (prev < 0) q->head[level] = idx;
+    else q->next[prev] = idx;
+    q->len++;
+}
+
+int prio_rq_first_level(const struct prio_rq *q) {
+    if (!q->summary) return -1;
+    int w = __builtin_ctzll(q->summary);
+    return (w << 6) + __builtin_ctzll(q->bitmap[w]);
+}
+
+/* First non-empty level at or after from, -1 if none. */
+int prio_rq_next_level(const struct prio_rq *q, int from) {
+    if (from >= q->levels) return -1;
+
+    int w = from >> 6;
+    uint64_t bits = q->bitmap[w] & (~0ULL << (from & 63));
+    if (bits) return (w << 6) + __builtin_ctzll(bits);
+
+    uint64_t rest = (w + 1 < 64) ? q->summary & (~0ULL << (w + 1)) : 0;
+    if (!rest) return -1;
+    w = __builtin_ctzll(rest);
+    return (w << 6) + __builtin_ctzll(q->bitmap[w]);
+}
+
+int prio_rq_pop_level(struct prio_rq *q, int level) {
+    int idx = q->head[level];
+    if (idx < 0) return -1;
+
+    q->head[level] = q->next[idx];
+    if (q->head[level] < 0) {
+        q->tail[level] = -1;
+        q->bitmap[level >> 6] &= ~(1ULL << (level & 63));
+        if (!q->bitmap[level >> 6]) q->summary &= ~(1ULL << (level >> 6));
+    }
+    q->len--;
+    return idx;
+}
+
+/* Move every queued job onto one level, keeping level-then-FIFO order. O(levels). */
+void prio_rq_splice_all(struct prio_rq *q, int level) {
+    int head = -1, tail = -1;
+
+    for (int l = prio_rq_first_level(q); l >= 0; l = prio_rq_next_level(q, l + 1)) {
+        if (head < 0) head = q->head[l];
+        else q->next[tail] = q->head[l];
+        tail = q->tail[l];
+        q->head[l] = q->tail[l] = -1;
+    }
+    if (head < 0) return;
+
+    memset(q->bitmap, 0, (size_t)(q->levels + 63) / 64 * sizeof(uint64_t));
+    q->summary = 0;
+    q->head[level] = head;
+    q->tail[level] = tail;
+    q->bitmap[level >> 6] |= 1ULL << (level & 63);
+    q->summary |= 1ULL << (level >> 6);
+}
+
+int prio_rq_pop(struct prio_rq *q) {
+    int level = prio_rq_first_level(q);
+    return (level < 0) ? -1 : prio_rq_pop_level(q, level);
+}
+
+// ================= RED-BLACK TREE =================
+
+int rb_init(struct rbtree *t, int njobs) {
+    memset(t, 0, sizeof(*t));
+    size_t slots = (size_t)njobs + 1;
+
+    t->left = malloc(slots * sizeof(int));
+    t->right = malloc(slots * sizeof(int));
+    t->parent = malloc(slots * sizeof(int));
+    t->red = calloc(slots, 1);
+    t->key = malloc(slots * sizeof(double));
+    if (!t->left || !t->right || !t->parent || !t->red || !t->key) {
+        rb_free(t);
+        return -1;
+    }
+    t->nil = njobs;
+    t->root = t->leftmost = t->nil;
+    t->left[t->nil] = t->right[t->nil] = t->parent[t->nil] = t->nil;
+    return 0;
+}
+
+/* An empty tree over the same jobs as links, sharing its arrays and sentinel. */
+void rb_init_shared(struct rbtree *t, const struct rbtree *links) {
+    *t = *links;
+    t->root = t->leftmost = t->nil;
+    t->len = 0;
+    t->borrowed = 1;
+}
+
+void rb_free(struct rbtree *t) {
+    if (!t->borrowed) {
+        free(t->left);
+        free(t->right);
+        free(t->parent);
+        free(t->red);
+        free(t->key);
+    }
+    memset(t, 0, sizeof(*t));
+}
+
+static inline int rb_less(const struct rbtree *t, int a, int b) {
+    return t->key[a] < t->key[b] || (t->key[a] == t->key[b] && a < b);
+}
+
+static void rotate_left(struct rbtree *t, int x) {
+    int y = t->right[x];
+    t->right[x] = t->left[y];
+    if (t->left[y] != t->nil) t->parent[t->left[y]] = x;
+    t->parent[y] = t->parent[x];
+    if (t->parent[x] == t->nil) t->root = y;
+    else if (x == t->left[t->parent[x]]) t->left[t->parent[x]] = y;
+    else t->right[t->parent[x]] = y;
+    t->left[y] = x;
+    t->parent[x] = y;
+}
+
+static void rotate_right(struct rbtree *t, int x) {
+    int y = t->left[x];
+    t->left[x] = t->right[y];
+    if (t->right[y] != t->nil) t->parent[t->right[y]] = x;
+    t->parent[y] = t->parent[x];
+    if (t->parent[x] == t->nil) t->root = y;
+    else if (x == t->right[t->parent[x]]) t->right[t->parent[x]] = y;
+    else t->left[t->parent[x]] = y;
+    t->right[y] = x;
+    t->parent[x] = y;
+}
+
+void rb_insert(struct rbtree *t, int z, double key) {
+    int y = t->nil, x = t->root;
+
+    t->key[z] = key;
+    while (x != t->nil) {
+        y = x;
+        x = rb_less(t, z, x) ? t->left[x] : t->right[x];
+    }
+    t->parent[z] = y;
+    if (y == t->nil) t->root = z;
+    else if (rb_less(t, z, y)) t->left[y] = z;
+    else t->right[y] = z;
+    t->left[z] = t->right[z] = t->nil;
+    t->red[z] = 1;
+
+    if (t->len++ == 0 || rb_less(t, z, t->leftmost)) t->leftmost = z;
+
+    while (t->red[t->parent[z]]) {
+        int p = t->parent[z], g = t->parent[p];
+        if (p == t->left[g]) {
+            int u = t->right[g];
+            if (t->red[u]) {
+                t->red[p] = t->red[u] = 0;
+                t->red[g] = 1;
+                z = g;
+            } else {
+                if (z == t->right[p]) {
+                    z = p;
+                    rotate_left(t, z);
+                    p = t->parent[z];
+                }
+                t->red[p] = 0;
+                t->red[g] = 1;
+                rotate_right(t, g);
+            }
+        } else {
+            int u = t->left[g];
+            if (t->red[u]) {
+                t->red[p] = t->red[u] = 0;
+                t->red[g] = 1;
+                z = g;
+            } else {
+                if (z == t->left[p]) {
+                    z = p;
+                    rotate_right(t, z);
+                    p = t->parent[z];
+                }
+                t->red[p] = 0;
+                t->red[g] = 1;
+                rotate_left(t, g);
+            }
+        }
+    }
+    t->red[t->root] = 0;
+}
+
+static void transplant(struct rbtree *t, int u, int v) {
+    if (t->parent[u] == t->nil) t->root = v;
+    else if (u == t->left[t->parent[u]]) t->left[t->parent[u]] = v;
+    else t->right[t->parent[u]] = v;
+    t->parent[v] = t->parent[u];
+}
+
+static int subtree_min(const struct rbtree *t, int x) {
+    while (t->left[x] != t->nil) x = t->left[x];
+    return x;
+}
+
+static int successor(const struct rbtree *t, int x) {
+    if (t->right[x] != t->nil) return subtree_min(t, t->right[x]);
+    int y = t->parent[x];
+    while (y != t->nil && x == t->right[y]) {
+        x = y;
+        y = t->parent[y];
+    }
+    return y;
+}
+
+void rb_erase(struct rbtree *t, int z) {
+    if (z == t->leftmost) t->leftmost = successor(t, z);
+
+    int y = z, x;
+    int y_red = t->red[y];
+
+    if (t->left[z] == t->nil) {
+        x = t->right[z];
+        transplant(t, z, x);
+    } else if (t->right[z] == t->nil) {
+        x = t->left[z];
+        transplant(t, z, x);
+    } else {
+        y = subtree_min(t, t->right[z]);
+        y_red = t->red[y];
+        x = t->right[y];
+        if (t->parent[y] == z) {
+            t->parent[x] = y;
+        } else {
+            transplant(t, y, x);
+            t->right[y] = t->right[z];
+            t->parent[t->right[y]] = y;
+        }
+        transplant(t, z, y);
+        t->left[y] = t->left[z];
+        t->parent[t->left[y]] = y;
+        t->red[y] = t->red[z];
+    }
+    t->len--;
+
+    if (!y_red) {
+        while (x != t->root && !t->red[x]) {
+            int p = t->parent[x];
+            if (x == t->left[p]) {
+                int w = t->right[p];
+                if (t->red[w]) {
+                    t->red[w] = 0;
+                    t->red[p] = 1;
+                    rotate_left(t, p);
+                    w = t->right[p];
+                }
+                if (!t->red[t->left[w]] && !t->red[t->right[w]]) {
+                    t->red[w] = 1;
+                    x = p;
+                } else {
+                    if (!t->red[t->right[w]]) {
+                        t->red[t->left[w]] = 0;
+                        t->red[w] = 1;
+                        rotate_right(t, w);
+                        w = t->right[p];
+                    }
+                    t->red[w] = t->red[p];
+                    t->red[p] = 0;
+                    t->red[t->right[w]] = 0;
+                    rotate_left(t, p);
+                    x = t->root;
+                }
+            } else {
+                int w = t->left[p];
+                if (t->red[w]) {
+                    t->red[w] = 0;
+                    t->red[p] = 1;
+                    rotate_right(t, p);
+                    w = t->left[p];
+                }
+                if (!t->red[t->right[w]] && !t->red[t->left[w]]) {
+                    t->red[w] = 1;
+                    x = p;
+                } else {
+                    if (!t->red[t->left[w]]) {
+                        t->red[t->right[w]] = 0;
+                        t->red[w] = 1;
+                        rotate_left(t, w);
+                        w = t->left[p];
+                    }
+                    t->red[w] = t->red[p];
+                    t->red[p] = 0;
+                    t->red[t->left[w]] = 0;
+                    rotate_right(t, p);
+                    x = t->root;
+                }
+            }
+        }
+        t->red[x] = 0;
+    }
+    t->red[t->nil] = 0;
+    t->parent[t->nil] = t->nil;
+}
@@ -0,0 +1,149 @@
+#ifndef SCHED_QUEUE_H
+#define SCHED_QUEUE_H
+
+#include <stdint.h>
+
+// ================= FIFO RING =================
+
+/*
+ * Circular queue of job indices. It doubles when full, so capacity
+ * tracks the longest queue seen rather than the job count, and stops
+ * allocating once that high-water mark is reached.
+ */
+struct fifo {
+    int *buf;
+    int cap;
+    int head, len;
+};
+
+int  fifo_init(struct fifo *q, int cap);
+void fifo_free(struct fifo *q);
+int  fifo_grow(struct fifo *q);
+
+static inline int fifo_empty(const struct fifo *q) { return q->len == 0; }
+
+static inline int fifo_push(struct fifo *q, int idx) {
+    if (q->len == q->cap && fifo_grow(q) != 0) return -1;
+    int tail = q->head + q->len;
+    if (tail >= q->cap) tail -= q->cap;
+    q->buf[tail] = idx;
+    q->len++;
+    return 0;
+}
+
+static inline int fifo_pop(struct fifo *q) {
+    if (q->len == 0) return -1;
+    int idx = q->buf[q->head];
+    if (++q->head == q->cap) q->head = 0;
+    q->len--;
+    return idx;
+}
+
+// ================= JOB BITMAP =================
+
+/* One bit per job, for O(1) membership tests. */
+struct bitset {
+    uint64_t *w;
+    int nbits;
+};
+
+int  bitset_init(struct bitset *b, int nbits);
+void bitset_free(struct bitset *b);
+
+static inline int bitset_test(const struct bitset *b, int i) {
+    return (b->w[i >> 6] >> (i & 63)) & 1;
+}
+
+static inline void bitset_set(struct bitset *b, int i) {
+    b->w[i >> 6] |= 1ULL << (i & 63);
+}
+
+static inline void bitset_clear(struct bitset *b, int i) {
+    b->w[i >> 6] &= ~(1ULL << (i & 63));
+}
+
+// ================= BINARY MIN-HEAP =================
+
+/*
+ * Ready jobs ordered by (key, idx): smallest key first, ties to the
+ * lower index. The array doubles when full.
+ */
+struct heap_node {
+    double key;
+    int idx;
+};
+
+struct heap {
+    struct heap_node *node;
+    int cap, len;
+};
+
+int  heap_init(struct heap *h, int cap);
+void heap_free(struct heap *h);
+int  heap_push(struct heap *h, double key, int idx);
+int  heap_pop(struct heap *h);
+
+static inline int heap_empty(const struct heap *h) { return h->len == 0; }
+
+// ================= BITMAP PRIORITY RUN QUEUE =================
+
+/*
+ * O(1) multi-level run queue in the style of the Linux 2.6 O(1)
+ * scheduler: one FIFO per priority level (level 0 runs first) and a
+ * two-level find-first-set bitmap over the non-empty levels. The FIFOs
+ * are linked through a per-job next[] array, so nothing is allocated
+ * after init. A job sits in at most one queue, so the per-CPU queues of
+ * an SMP run borrow the first queue's next[] instead of each holding one.
+ */
+#define PRIO_RQ_MAX_LEVELS 4096
+
+struct prio_rq {
+    int levels;
+    int len;
+    uint64_t summary;
+    uint64_t *bitmap;
+    int *head, *tail;
+    int *next;
+    int borrowed;
+};
+
+int  prio_rq_init(struct prio_rq *q, int levels, int njobs);
+int  prio_rq_init_shared(struct prio_rq *q, int levels, const struct prio_rq *links);
+void prio_rq_free(struct prio_rq *q);
+void prio_rq_push(struct prio_rq *q, int level, int idx);
+void prio_rq_push_ordered(struct prio_rq *q, int level, int idx, const double *key);
+int  prio_rq_pop(struct prio_rq *q);
+int  prio_rq_pop_level(struct prio_rq *q, int level);
+int  prio_rq_first_level(const struct prio_rq *q);
+int  prio_rq_next_level(const struct prio_rq *q, int from);
+void prio_rq_splice_all(struct prio_rq *q, int level);
+
+static inline int prio_rq_head(const struct prio_rq *q, int level) { return q->head[level]; }
+
+// ================= RED-BLACK TREE =================
+
+/*
+ * Intrusive red-black tree of job indices ordered by (key, idx), with
+ * the leftmost node cached as CFS does. Links live in per-job arrays
+ * sized at init; slot njobs is the black NIL sentinel. Trees over
+ * disjoint sets of the same jobs can share one set of link arrays.
+ */
+struct rbtree {
+    int *left, *right, *parent;
+    unsigned char *red;
+    double *key;
+    int root, nil;
+    int leftmost;
+    int len;
+    int borrowed;
+};
+
+int  rb_init(struct rbtree *t, int njobs);
+void rb_init_shared(struct rbtree *t, const struct rbtree *links);
+void rb_free(struct rbtree *t);
+void rb_insert(struct rbtree *t, int idx, double key);
+void rb_erase(struct rbtree *t, int idx);
+
+static inline int rb_first(const struct rbtree *t) { return t->len ? t->leftmost : -1; }
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef SCHED_RAND_H
+#define SCHED_RAND_H
+
+#include <stdint.h>
+
+// ================= COUNTER-BASED RANDOM STREAMS =================
+
+/*
+ * Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as
+ * 1, 2, 3"). Output block i of stream s under key k is a pure function
+ * of (k, s, i), so any number of independent streams can be drawn in
+ * any order, on any thread, and still reproduce from one seed.
+ */
+struct sched_rng {
+    uint32_t key[2];
+    uint32_t ctr[4];    // block index (low 64 bits) and stream id (high 64 bits)
+    uint32_t out[4];
+    int avail;
+};
+
+static inline void philox_round(uint32_t ctr[4], const uint32_t key[2]) {
+    uint64_t p0 = (uint64_t)0xD2511F53u * ctr[0];
+    uint64_t p1 = (uint64_t)0xCD9E8D57u * ctr[2];
+    uint32_t c0 = (uint32_t)(p1 >> 32) ^ ctr[1] ^ key[0];
+    uint32_t c2 = (uint32_t)(p0 >> 32) ^ ctr[3] ^ key[1];
+    ctr[0] = c0;
+    ctr[1] = (uint32_t)p1;
+    ctr[2] = c2;
+    ctr[3] = (uint32_t)p0;
+}
+
+static inline void philox4x32_10(const uint32_t in[4], const uint32_t key[2], uint32_t out[4]) {
+    uint32_t k[2] = { key[0], key[1] };
+    for (int i = 0; i < 4; i++) out[i] = in[i];
+    for (int r = 0; r < 10; r++) {
+        philox_round(out, k);
+        k[0] += 0x9E3779B9u;
+        k[1] += 0xBB67AE85u;
+    }
+}
+
+static inline void rng_init(struct sched_rng *r, uint64_t seed, uint64_t stream) {
+    r->key[0] = (uint32_t)seed;
+    r->key[1] = (uint32_t)(seed >> 32);
+    r->ctr[0] = r->ctr[1] = 0;
+    r->ctr[2] = (uint32_t)stream;
+    r->ctr[3] = (uint32_t)(stream >> 32);
+    r->avail = 0;
+}
+
+static inline uint32_t rng_next32(struct sched_rng *r) {
+    if (r->avail == 0) {
+        philox4x32_10(r->ctr, r->key, r->out);
+        if (++r->ctr[0] == 0) r->ctr[1]++;
+        r->avail = 4;
+    }
+    return r->out[--r->avail];
+}
+
+/* Uniform in [0, n), by multiply-shift rather than modulo. */
+static inline uint32_t rng_below(struct sched_rng *r, uint32_t n) {
+    return (uint32_t)(((uint64_t)rng_next32(r) * n) >> 32);
+}
+
+#endif
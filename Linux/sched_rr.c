@@ -0,0 +1,75 @@
+#include <stdlib.h>
+
+#include "sched_engine.h"
+#include "sched_queue.h"
+
+// ================= ROUND ROBIN POLICY =================
+
+/*
+ * Growable ring of ready jobs per CPU plus one "queued" bit per job. The
+ * engine admits arrivals through its arrival-sorted cursor, and the bit
+ * makes a repeated enqueue of an already waiting job an O(1) no-op
+ * instead of a rescan of the queue.
+ */
+#define RR_INITIAL_CAP 1024
+
+struct rr_state {
+    struct fifo *q;
+    struct bitset queued;
+};
+
+static void rr_destroy(struct sched_ctx *c) {
+    struct rr_state *s = c->pdata;
+    if (!s) return;
+    if (s->q)
+        for (int k = 0; k < c->cfg.ncpu; k++) fifo_free(&s->q[k]);
+    free(s->q);
+    bitset_free(&s->queued);
+    free(s);
+}
+
+static int rr_init(struct sched_ctx *c) {
+    struct rr_state *s = calloc(1, sizeof(*s));
+    if (!s) return -1;
+    c->pdata = s;
+
+    int ok = (s->q = calloc(c->cfg.ncpu, sizeof(*s->q))) != NULL &&
+             bitset_init(&s->queued, c->wl->n) == 0;
+    for (int k = 0; ok && k < c->cfg.ncpu; k++)
+        ok = fifo_init(&s->q[k], RR_INITIAL_CAP) == 0;
+    if (!ok) {
+        rr_destroy(c);
+        c->pdata = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+static int rr_enqueue(struct sched_ctx *c, int idx) {
+    struct rr_state *s = c->pdata;
+    if (bitset_test(&s->queued, idx)) return 0;
+    if (fifo_push(&s->q[c->rq], idx) != 0) return -1;
+    bitset_set(&s->queued, idx);
+    return 0;
+}
+
+static int rr_pick(struct sched_ctx *c) {
+    struct rr_state *s = c->pdata;
+    int idx = fifo_pop(&s->q[c->rq]);
+    if (idx >= 0) bitset_clear(&s->queued, idx);
+    return idx;
+}
+
+static double rr_slice(struct sched_ctx *c, int idx) {
+    double rem = c->p.rem[idx];
+    return (rem > c->cfg.quantum) ? c->cfg.quantum : rem;
+}
+
+const struct sched_policy sched_rr = {
+    .name = "RR",
+    .init = rr_init,
+    .destroy = rr_destroy,
+    .enqueue = rr_enqueue,
+    .pick = rr_pick,
+    .slice = rr_slice,
+};
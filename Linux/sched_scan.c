@@ -0,0 +1,415 @@
+#define _POSIX_C_SOURCE 200809L
+#include <float.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sched_scan.h"
+#include "sched_simd.h"
+
+// ================= WORKERS =================
+
+#define SCAN_MAX_THREADS 256
+#define SCAN_MIN_JOBS 65536     // per worker; smaller runs stay on one thread
+#define SCAN_LANES 4            // independent blocks each worker interleaves
+
+int scan_threads(int want) {
+    if (want <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        want = online > 0 ? (int)online : 1;
+    }
+    return want > SCAN_MAX_THREADS ? SCAN_MAX_THREADS : want;
+}
+
+static int threads_for(int want, int n) {
+    int t = scan_threads(want);
+    int most = n / SCAN_MIN_JOBS + 1;
+    return t < most ? t : most;
+}
+
+struct worker {
+    void (*fn)(void *arg, int t);
+    void *arg;
+    int t;
+    pthread_t tid;
+    int spawned;
+};
+
+static void *worker_main(void *arg) {
+    struct worker *w = arg;
+    w->fn(w->arg, w->t);
+    return NULL;
+}
+
+/* fn(arg, t) for t = 0..nthreads-1; the caller is worker 0 and runs any that fail to spawn. */
+static void run_workers(int nthreads, void (*fn)(void *arg, int t), void *arg) {
+    struct worker w[SCAN_MAX_THREADS];
+
+    for (int t = 1; t < nthreads; t++) {
+        w[t] = (struct worker){ fn, arg, t, 0, 0 };
+        w[t].spawned = pthread_create(&w[t].tid, NULL, worker_main, &w[t]) == 0;
+    }
+    fn(arg, 0);
+    for (int t = 1; t < nthreads; t++) {
+        if (w[t].spawned)
+            pthread_join(w[t].tid, NULL);
+        else
+            fn(arg, t);
+    }
+}
+
+static inline int chunk_lo(int n, int parts, int k) {
+    return (int)((long long)n * k / parts);
+}
+
+// ================= RADIX SORT =================
+
+/*
+ * Eight passes of eight bits over keys mapped to unsigned integers that
+ * order like the doubles. A pass whose digit is the same for every key
+ * is skipped, which for arrival times drops most of the low mantissa
+ * bytes. Each worker counts and scatters its own chunk, and the chunks
+ * are laid out in worker order within a digit, so every pass is stable.
+ */
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES (64 / RADIX_BITS)
+
+struct radix {
+    const double *key;
+    uint64_t *k[2];
+    int *idx[2];
+    int n, nthreads;
+    int src, shift;
+    size_t (*count)[RADIX_BUCKETS];     // nthreads rows
+    size_t (*total)[RADIX_BUCKETS];     // RADIX_PASSES rows per worker
+};
+
+static inline uint64_t order_bits(double v) {
+    uint64_t u;
+    v += 0.0;   // -0 sorts with +0
+    memcpy(&u, &v, sizeof(u));
+    return (u >> 63) ? ~u : u | (1ULL << 63);
+}
+
+static void radix_keys(void *arg, int t) {
+    struct radix *r = arg;
+    size_t (*tot)[RADIX_BUCKETS] = r->total + (size_t)t * RADIX_PASSES;
+    int lo = chunk_lo(r->n, r->nthreads, t), hi = chunk_lo(r->n, r->nthreads, t + 1);
+
+    memset(tot, 0, RADIX_PASSES * sizeof(*tot));
+    for (int i = lo; i < hi; i++) {
+        uint64_t u = order_bits(r->key[i]);
+        r->k[0][i] = u;
+        r->idx[0][i] = i;
+        for (int p = 0; p < RADIX_PASSES; p++) tot[p][(u >> (p * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+    }
+}
+
+static void radix_count(void *arg, int t) {
+    struct radix *r = arg;
+    const uint64_t *k = r->k[r->src];
+    size_t *cnt = r->count[t];
+    int lo = chunk_lo(r->n, r->nthreads, t), hi = chunk_lo(r->n, r->nthreads, t + 1);
+
+    memset(cnt, 0, RADIX_BUCKETS * sizeof(*cnt));
+    for (int i = lo; i < hi; i++) cnt[(k[i] >> r->shift) & (RADIX_BUCKETS - 1)]++;
+}
+
+static void radix_scatter(void *arg, int t) {
+    struct radix *r = arg;
+    const uint64_t *k = r->k[r->src];
+    const int *idx = r->idx[r->src];
+    uint64_t *dk = r->k[!r->src];
+    int *di = r->idx[!r->src];
+    size_t *off = r->count[t];
+    int lo = chunk_lo(r->n, r->nthreads, t), hi = chunk_lo(r->n, r->nthreads, t + 1);
+
+    for (int i = lo; i < hi; i++) {
+        size_t to = off[(k[i] >> r->shift) & (RADIX_BUCKETS - 1)]++;
+        dk[to] = k[i];
+        di[to] = idx[i];
+    }
+}
+
+int radix_sort_by_key(const double *key, int n, int *out, int nthreads) {
+    struct radix r = { .key = key, .n = n, .idx = { out, NULL } };
+    int rc = -1;
+
+    r.nthreads = threads_for(nthreads, n);
+    r.k[0] = malloc((size_t)n * sizeof(uint64_t));
+    r.k[1] = malloc((size_t)n * sizeof(uint64_t));
+    r.idx[1] = malloc((size_t)n * sizeof(int));
+    r.count = malloc((size_t)r.nthreads * sizeof(*r.count));
+    r.total = malloc((size_t)r.nthreads * RADIX_PASSES * sizeof(*r.total));
+    if (!r.k[0] || !r.k[1] || !r.idx[1] || !r.count || !r.total) goto out;
+
+    run_workers(r.nthreads, radix_keys, &r);
+
+    for (int p = 0; p < RADIX_PASSES; p++) {
+        int uniform = 0;
+        for (int d = 0; d < RADIX_BUCKETS && !uniform; d++) {
+            size_t sum = 0;
+            for (int t = 0; t < r.nthreads; t++) sum += r.total[(size_t)t * RADIX_PASSES + p][d];
+            uniform = sum == (size_t)n;
+        }
+        if (uniform) continue;
+
+        r.shift = p * RADIX_BITS;
+        run_workers(r.nthreads, radix_count, &r);
+        size_t at = 0;
+        for (int d = 0; d < RADIX_BUCKETS; d++) {
+            for (int t = 0; t < r.nthreads; t++) {
+                size_t c = r.count[t][d];
+                r.count[t][d] = at;
+                at += c;
+            }
+        }
+        run_workers(r.nthreads, radix_scatter, &r);
+        r.src = !r.src;
+    }
+    if (r.src) memcpy(out, r.idx[1], (size_t)n * sizeof(int));
+    rc = 0;
+
+out:
+    free(r.k[0]);
+    free(r.k[1]);
+    free(r.idx[1]);
+    free(r.count);
+    free(r.total);
+    return rc;
+}
+
+// ================= FCFS SCAN =================
+
+/*
+ * Three passes over the jobs in arrival order, cut into SCAN_LANES
+ * blocks per worker:
+ *   1. every block runs the recurrence as if the CPU were free when its
+ *      first job arrives; a worker steps its blocks in lockstep so their
+ *      dependency chains overlap in the pipeline;
+ *   2. one thread walks the block boundaries with the true finish time,
+ *      redoing a block only until it reproduces the speculative values,
+ *      after which the rest of the block is already right;
+ *   3. the workers derive WT/TAT/RT, the histograms, stalled dispatches
+ *      and the deepest queue from the final start and finish times.
+ * A trace with idle gaps converges within a busy period of each
+ * boundary; one that never lets the CPU idle leaves pass 2 serial.
+ *
+ * The passes stream columns in arrival order. A sorted trace already
+ * is; any other is gathered into that order first and its start and
+ * finish times scattered back to job order in pass 3.
+ */
+struct fcfs_scan {
+    struct sched_ctx *c;
+    const int *ord;
+    int n, nthreads, nblocks;
+    int gathered;               // at/bt/st/ft below are copies, not the job columns
+    const double *at, *bt;      // by arrival position
+    double *st, *ft;
+    double t0;                  // the clock when the run starts
+    struct sched_hist *hist;    // SCHED_METRICS per worker
+    long *swaps;
+    int *max_queued;
+};
+
+/* Bitwise, so a speculative -0 start is not taken for the true +0. */
+static inline int same_bits(double a, double b) {
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+/* One dispatch, with the same operations as dispatch() and slice_end(). */
+static inline double fcfs_step(double prev, double at, double bt, double swap, double *st) {
+    double s = at > prev ? at : prev;
+    if (swap > 0 && (s - at) > SCHED_SWAP_WAIT) s += swap;
+    *st = s;
+    return s + bt;
+}
+
+static void gather_jobs(void *arg, int t) {
+    struct fcfs_scan *s = arg;
+    double *at = (double *)s->at, *bt = (double *)s->bt;
+    int lo = chunk_lo(s->n, s->nthreads, t), hi = chunk_lo(s->n, s->nthreads, t + 1);
+
+    for (int i = lo; i < hi; i++) {
+        at[i] = s->c->wl->at[s->ord[i]];
+        bt[i] = s->c->wl->bt[s->ord[i]];
+    }
+}
+
+static void scan_blocks(void *arg, int t) {
+    struct fcfs_scan *s = arg;
+    double swap = s->c->cfg.swap_time;
+    int pos[SCAN_LANES], end[SCAN_LANES], steps = INT_MAX;
+    double prev[SCAN_LANES];
+
+    for (int l = 0; l < SCAN_LANES; l++) {
+        int b = t * SCAN_LANES + l;
+        pos[l] = chunk_lo(s->n, s->nblocks, b);
+        end[l] = chunk_lo(s->n, s->nblocks, b + 1);
+        prev[l] = (pos[l] == 0) ? s->t0 : -DBL_MAX;
+        if (end[l] - pos[l] < steps) steps = end[l] - pos[l];
+    }
+    // Blocks differ in length by at most one job: lockstep over the common part
+    for (int k = 0; k < steps; k++) {
+        for (int l = 0; l < SCAN_LANES; l++) {
+            int i = pos[l] + k;
+            prev[l] = s->ft[i] = fcfs_step(prev[l], s->at[i], s->bt[i], swap, &s->st[i]);
+        }
+    }
+    for (int l = 0; l < SCAN_LANES; l++)
+        for (int i = pos[l] + steps; i < end[l]; i++)
+            prev[l] = s->ft[i] = fcfs_step(prev[l], s->at[i], s->bt[i], swap, &s->st[i]);
+}
+
+static void carry_blocks(struct fcfs_scan *s) {
+    double swap = s->c->cfg.swap_time;
+    double carry = s->t0;
+
+    for (int b = 0; b < s->nblocks; b++) {
+        int lo = chunk_lo(s->n, s->nblocks, b), hi = chunk_lo(s->n, s->nblocks, b + 1);
+        if (lo == hi) continue;
+        for (int i = lo; i < hi; i++) {
+            double st;
+            double ft = fcfs_step(carry, s->at[i], s->bt[i], swap, &st);
+            if (same_bits(ft, s->ft[i]) && same_bits(st, s->st[i])) break;
+            s->st[i] = st;
+            s->ft[i] = ft;
+            carry = ft;
+        }
+        carry = s->ft[hi - 1];
+    }
+}
+
+static void scan_results(void *arg, int t) {
+    struct fcfs_scan *s = arg;
+    struct sched_ctx *c = s->c;
+    struct proc_table *p = &c->p;
+    struct sched_hist *h = s->hist + (size_t)t * SCHED_METRICS;
+    double swap = c->cfg.swap_time;
+    long swaps = 0;
+    int maxq = 0;
+
+    int lo = chunk_lo(s->n, s->nblocks, t * SCAN_LANES);
+    int hi = chunk_lo(s->n, s->nblocks, (t + 1) * SCAN_LANES);
+    for (int m = 0; m < SCHED_METRICS; m++) hist_reset(&h[m]);
+    if (lo == hi) goto out;
+
+    double prev = (lo == 0) ? s->t0 : s->ft[lo - 1];
+    double first = s->at[lo] > prev ? s->at[lo] : prev;
+
+    // Arrivals up to a dispatch are queued before it: binary search once, then walk
+    int u = lo, top = s->n;
+    while (u < top) {
+        int mid = u + (top - u) / 2;
+        if (s->at[mid] <= first) u = mid + 1; else top = mid;
+    }
+
+    for (int i = lo; i < hi; i++) {
+        int j = s->ord[i];
+        double a = s->at[i];
+        double now = a > prev ? a : prev;
+
+        if (swap > 0 && (now - a) > SCHED_SWAP_WAIT) swaps++;
+        while (u < s->n && s->at[u] <= now) u++;
+        if (u - i > maxq) maxq = u - i;
+
+        double tat = s->ft[i] - a;
+        double wt = tat - s->bt[i];
+        double rt = s->st[i] - a;
+        if (s->gathered) {
+            p->st[j] = s->st[i];
+            p->ft[j] = s->ft[i];
+        }
+        p->tat[j] = tat;
+        p->wt[j] = wt;
+        p->rt[j] = rt;
+        p->rem[j] = 0;
+        p->started[j] = 1;
+        p->ready[j] = a > s->t0 ? a : s->t0;
+        c->done_order[i] = j;
+
+        hist_add(&h[METRIC_WT], wt);
+        hist_add(&h[METRIC_TAT], tat);
+        hist_add(&h[METRIC_RT], rt);
+        prev = s->ft[i];
+    }
+
+out:
+    s->swaps[t] = swaps;
+    s->max_queued[t] = maxq;
+}
+
+int fcfs_scan_applies(const struct sched_ctx *c) {
+    return c->policy == &sched_fcfs && c->cfg.ncpu == 1 && c->cfg.threads >= 0 && !c->mem &&
+           !c->trace && !c->on_slice && c->completed == 0 && c->next_arrival == 0;
+}
+
+static void scan_free(struct fcfs_scan *s) {
+    if (s->gathered) {
+        free((double *)s->at);
+        free((double *)s->bt);
+        free(s->st);
+        free(s->ft);
+    }
+    free(s->hist);
+    free(s->swaps);
+    free(s->max_queued);
+}
+
+int fcfs_scan(struct sched_ctx *c) {
+    struct fcfs_scan s = { .c = c, .ord = c->by_arrival, .n = c->wl->n, .t0 = c->now };
+    struct timespec ls, le;
+
+    clock_gettime(CLOCK_MONOTONIC, &ls);
+    s.nthreads = threads_for(c->cfg.threads, s.n);
+    s.nblocks = s.nthreads * SCAN_LANES;
+    for (int i = 0; i < s.n && !s.gathered; i++) s.gathered = s.ord[i] != i;
+    if (s.gathered) {
+        s.at = malloc((size_t)s.n * sizeof(double));
+        s.bt = malloc((size_t)s.n * sizeof(double));
+        s.st = malloc((size_t)s.n * sizeof(double));
+        s.ft = malloc((size_t)s.n * sizeof(double));
+    } else {
+        s.at = c->wl->at;
+        s.bt = c->wl->bt;
+        s.st = c->p.st;
+        s.ft = c->p.ft;
+    }
+    s.hist = malloc((size_t)s.nthreads * SCHED_METRICS * sizeof(*s.hist));
+    s.swaps = calloc(s.nthreads, sizeof(long));
+    s.max_queued = calloc(s.nthreads, sizeof(int));
+    if (!s.at || !s.bt || !s.st || !s.ft || !s.hist || !s.swaps || !s.max_queued) {
+        scan_free(&s);
+        return -1;
+    }
+
+    if (s.gathered) run_workers(s.nthreads, gather_jobs, &s);
+    run_workers(s.nthreads, scan_blocks, &s);
+    carry_blocks(&s);
+    run_workers(s.nthreads, scan_results, &s);
+
+    struct sched_cpu *cpu = &c->cpu[0];
+    long swaps = 0;
+    for (int t = 0; t < s.nthreads; t++) {
+        for (int m = 0; m < SCHED_METRICS; m++) hist_merge(&c->hist[m], &s.hist[(size_t)t * SCHED_METRICS + m]);
+        swaps += s.swaps[t];
+        if (s.max_queued[t] > cpu->max_queued) cpu->max_queued = s.max_queued[t];
+    }
+    // One addition per stall, as the event loop accumulates it
+    for (long k = 0; k < swaps; k++) c->stats.swap_stall += c->cfg.swap_time;
+    c->stats.total_swaps = (int)swaps;
+    c->stats.dispatches = s.n;
+    cpu->dispatches = s.n;
+    cpu->busy = col_sum(c->wl->bt, (size_t)s.n);
+    c->completed = c->next_arrival = s.n;
+    if (s.n > 0) c->now = s.ft[s.n - 1];
+
+    scan_free(&s);
+    clock_gettime(CLOCK_MONOTONIC, &le);
+    c->stats.sched_latency = elapsed_sec(&ls, &le);
+    return 0;
+}
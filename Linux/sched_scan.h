@@ -0,0 +1,31 @@
+#ifndef SCHED_SCAN_H
+#define SCHED_SCAN_H
+
+#include "sched_engine.h"
+
+// ================= PARALLEL FCFS SCAN =================
+
+/*
+ * On one CPU without the memory model FCFS needs no event loop: in
+ * arrival order every job starts at max(previous finish, arrival), plus
+ * the legacy swap charge when it waited, and runs its whole burst. The
+ * scan evaluates that recurrence over blocks of jobs in parallel and
+ * then carries the true finish time across block boundaries, redoing a
+ * block only until it meets its own speculative result again. Every
+ * value is produced by the same floating-point operations, in the same
+ * order, as the event loop, so the results are bit-identical.
+ */
+
+/* Worker threads for `want` (0 = one per online CPU). */
+int scan_threads(int want);
+
+/* Stable order of 0..n-1 by key (LSD radix sort, -0 equal to +0). */
+int radix_sort_by_key(const double *key, int n, int *out, int nthreads);
+
+/* Whether sched_run may replace its event loop with fcfs_scan(). */
+int fcfs_scan_applies(const struct sched_ctx *c);
+
+/* The whole FCFS run: results, done order, histograms and dispatch statistics. */
+int fcfs_scan(struct sched_ctx *c);
+
+#endif
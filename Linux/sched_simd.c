@@ -0,0 +1,125 @@
+#include <float.h>
+#include <limits.h>
+
+#include "sched_simd.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && !defined(SCHED_NO_SIMD)
+#include <immintrin.h>
+#define SCHED_HAVE_AVX2 1
+#endif
+
+// ================= COLUMN KERNELS =================
+
+/* The fold shared by both paths: lane j plus lane j + 4, then pairwise. */
+static inline double fold8(const double acc[8]) {
+    double t0 = acc[0] + acc[4], t1 = acc[1] + acc[5];
+    double t2 = acc[2] + acc[6], t3 = acc[3] + acc[7];
+    return (t0 + t1) + (t2 + t3);
+}
+
+static void stats_scalar(const double *x, size_t n, struct col_stats *out) {
+    double acc[8] = { 0 };
+    double lo = DBL_MAX, hi = -DBL_MAX;
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        for (int j = 0; j < 8; j++) {
+            double v = x[i + j];
+            acc[j] += v;
+            lo = v < lo ? v : lo;
+            hi = v > hi ? v : hi;
+        }
+    }
+    double sum = fold8(acc);
+    for (; i < n; i++) {
+        sum += x[i];
+        lo = x[i] < lo ? x[i] : lo;
+        hi = x[i] > hi ? x[i] : hi;
+    }
+    *out = (struct col_stats){ sum, lo, hi };
+}
+
+static int max_int_scalar(const int *x, size_t n) {
+    int hi = INT_MIN;
+    for (size_t i = 0; i < n; i++) hi = x[i] > hi ? x[i] : hi;
+    return hi;
+}
+
+#ifdef SCHED_HAVE_AVX2
+__attribute__((target("avx2")))
+static void stats_avx2(const double *x, size_t n, struct col_stats *out) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d lo = _mm256_set1_pd(DBL_MAX), hi = _mm256_set1_pd(-DBL_MAX);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256d a = _mm256_loadu_pd(x + i), b = _mm256_loadu_pd(x + i + 4);
+        s0 = _mm256_add_pd(s0, a);
+        s1 = _mm256_add_pd(s1, b);
+        lo = _mm256_min_pd(lo, _mm256_min_pd(a, b));
+        hi = _mm256_max_pd(hi, _mm256_max_pd(a, b));
+    }
+
+    double acc[8], l[4], h[4];
+    _mm256_storeu_pd(acc, s0);
+    _mm256_storeu_pd(acc + 4, s1);
+    _mm256_storeu_pd(l, lo);
+    _mm256_storeu_pd(h, hi);
+    double sum = fold8(acc);
+    double mn = l[0], mx = h[0];
+    for (int j = 1; j < 4; j++) {
+        mn = l[j] < mn ? l[j] : mn;
+        mx = h[j] > mx ? h[j] : mx;
+    }
+    for (; i < n; i++) {
+        sum += x[i];
+        mn = x[i] < mn ? x[i] : mn;
+        mx = x[i] > mx ? x[i] : mx;
+    }
+    *out = (struct col_stats){ sum, mn, mx };
+}
+
+__attribute__((target("avx2")))
+static int max_int_avx2(const int *x, size_t n) {
+    __m256i hi = _mm256_set1_epi32(INT_MIN);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8)
+        hi = _mm256_max_epi32(hi, _mm256_loadu_si256((const __m256i *)(x + i)));
+
+    int h[8], mx = INT_MIN;
+    _mm256_storeu_si256((__m256i *)h, hi);
+    for (int j = 0; j < 8; j++) mx = h[j] > mx ? h[j] : mx;
+    for (; i < n; i++) mx = x[i] > mx ? x[i] : mx;
+    return mx;
+}
+#endif
+
+void col_stats(const double *x, size_t n, struct col_stats *out) {
+#ifdef SCHED_HAVE_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        stats_avx2(x, n, out);
+        return;
+    }
+#endif
+    stats_scalar(x, n, out);
+}
+
+double col_sum(const double *x, size_t n) {
+    struct col_stats s;
+    col_stats(x, n, &s);
+    return s.sum;
+}
+
+double col_max(const double *x, size_t n) {
+    struct col_stats s;
+    col_stats(x, n, &s);
+    return s.max;
+}
+
+int col_max_int(const int *x, size_t n) {
+#ifdef SCHED_HAVE_AVX2
+    if (__builtin_cpu_supports("avx2")) return max_int_avx2(x, n);
+#endif
+    return max_int_scalar(x, n);
+}
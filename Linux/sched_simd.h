@@ -0,0 +1,25 @@
+#ifndef SCHED_SIMD_H
+#define SCHED_SIMD_H
+
+#include <stddef.h>
+
+// ================= COLUMN KERNELS =================
+
+/*
+ * Reductions over one result column, AVX2 where the CPU has it and a
+ * scalar loop otherwise (or everywhere when built with -DSCHED_NO_SIMD).
+ * Both paths keep eight partial sums, lane j taking every element with
+ * index j mod 8, and fold them in the same order, so a sum is the same
+ * bit for bit whichever path ran. No branches per element: the loops
+ * only stream the column through the adders and min/max units.
+ */
+struct col_stats {
+    double sum, min, max;
+};
+
+void   col_stats(const double *x, size_t n, struct col_stats *out);
+double col_sum(const double *x, size_t n);
+double col_max(const double *x, size_t n);
+int    col_max_int(const int *x, size_t n);
+
+#endif
@@ -0,0 +1,85 @@
+#include <stdlib.h>
+
+#include "sched_engine.h"
+#include "sched_queue.h"
+
+// ================= SJF POLICY =================
+
+/*
+ * The engine feeds jobs in arrival order; each CPU's ready queue is a
+ * min-heap keyed by burst so each dispatch costs O(log n). Equal bursts
+ * go to the lower job index, as the original linear scan did. Heaps
+ * start at an even share of the jobs and grow if balancing skews them.
+ */
+
+static void sjf_destroy(struct sched_ctx *c) {
+    struct heap *h = c->pdata;
+    if (!h) return;
+    for (int k = 0; k < c->cfg.ncpu; k++) heap_free(&h[k]);
+    free(h);
+}
+
+static int sjf_init(struct sched_ctx *c) {
+    struct heap *h = calloc(c->cfg.ncpu, sizeof(*h));
+    if (!h) return -1;
+    c->pdata = h;
+    for (int k = 0; k < c->cfg.ncpu; k++) {
+        if (heap_init(&h[k], c->wl->n / c->cfg.ncpu + 1) != 0) {
+            sjf_destroy(c);
+            c->pdata = NULL;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int sjf_enqueue(struct sched_ctx *c, int idx) {
+    struct heap *h = c->pdata;
+    return heap_push(&h[c->rq], c->wl->bt[idx], idx);
+}
+
+static int sjf_pick(struct sched_ctx *c) {
+    struct heap *h = c->pdata;
+    return heap_pop(&h[c->rq]);
+}
+
+static double sjf_slice(struct sched_ctx *c, int idx) {
+    return c->p.rem[idx];
+}
+
+const struct sched_policy sched_sjf = {
+    .name = "SJF",
+    .init = sjf_init,
+    .destroy = sjf_destroy,
+    .enqueue = sjf_enqueue,
+    .pick = sjf_pick,
+    .slice = sjf_slice,
+};
+
+// ================= SRTF POLICY =================
+
+/*
+ * Preemptive SJF on the same heap, keyed by remaining burst. A waiting
+ * job's remaining time cannot change, so the key set at enqueue stays
+ * valid; the running job is only re-evaluated when a job arrives.
+ */
+
+static int srtf_enqueue(struct sched_ctx *c, int idx) {
+    struct heap *h = c->pdata;
+    return heap_push(&h[c->rq], c->p.rem[idx], idx);
+}
+
+static int srtf_preempts(struct sched_ctx *c, int running, int idx) {
+    (void)running;
+    return c->p.rem[idx] < sched_running_rem(c);
+}
+
+const struct sched_policy sched_srtf = {
+    .name = "SRTF",
+    .init = sjf_init,
+    .destroy = sjf_destroy,
+    .enqueue = srtf_enqueue,
+    .pick = sjf_pick,
+    .slice = sjf_slice,
+    .preempts = srtf_preempts,
+};
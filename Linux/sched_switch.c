@@ -0,0 +1,309 @@
+#define _GNU_SOURCE
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sched_calib.h"
+#include "sched_switch.h"
+
+// ================= CONTEXT SWITCH COST =================
+
+const char *const switch_mech_names[SWITCH_NMECH] = { "pipe", "eventfd", "futex" };
+
+#define SWITCH_WARMUP 1000
+#define SWITCH_ROUNDS 10000     // round trips timed, two handoffs each
+
+/*
+ * One ping-pong pair. Direction 0 carries the token from side 0 to
+ * side 1, direction 1 carries it back. The futex words live in a shared
+ * mapping so the same code works across fork().
+ */
+struct pingpong {
+    enum switch_mech mech;
+    int pipe_fd[2][2];
+    int event_fd[2];
+    uint32_t *word;     // [2]
+    int cpu[2];
+    double secs;        // per handoff, set by side 0
+    int failed;
+};
+
+static void pin_to(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+}
+
+static int pp_signal(struct pingpong *p, int dir) {
+    uint64_t one = 1;
+    char c = 0;
+
+    switch (p->mech) {
+    case SWITCH_PIPE:
+        return write(p->pipe_fd[dir][1], &c, 1) == 1 ? 0 : -1;
+    case SWITCH_EVENTFD:
+        return write(p->event_fd[dir], &one, sizeof(one)) == sizeof(one) ? 0 : -1;
+    default:
+        __atomic_store_n(&p->word[dir], 1, __ATOMIC_RELEASE);
+        syscall(SYS_futex, &p->word[dir], FUTEX_WAKE, 1, NULL, NULL, 0);
+        return 0;
+    }
+}
+
+static int pp_wait(struct pingpong *p, int dir) {
+    uint64_t v;
+    char c;
+
+    switch (p->mech) {
+    case SWITCH_PIPE:
+        return read(p->pipe_fd[dir][0], &c, 1) == 1 ? 0 : -1;
+    case SWITCH_EVENTFD:
+        return read(p->event_fd[dir], &v, sizeof(v)) == sizeof(v) ? 0 : -1;
+    default:
+        // Strict alternation: the peer cannot signal again before we answer
+        while (__atomic_load_n(&p->word[dir], __ATOMIC_ACQUIRE) == 0)
+            syscall(SYS_futex, &p->word[dir], FUTEX_WAIT, 0, NULL, NULL, 0);
+        __atomic_store_n(&p->word[dir], 0, __ATOMIC_RELAXED);
+        return 0;
+    }
+}
+
+static int pp_side(struct pingpong *p, int side) {
+    struct timespec s = { 0 }, e;
+
+    pin_to(p->cpu[side]);
+    for (int i = 0; i < SWITCH_WARMUP + SWITCH_ROUNDS; i++) {
+        if (side == 0) {
+            if (i == SWITCH_WARMUP) clock_gettime(CLOCK_MONOTONIC, &s);
+            if (pp_signal(p, 0) != 0 || pp_wait(p, 1) != 0) return -1;
+        } else {
+            if (pp_wait(p, 0) != 0 || pp_signal(p, 1) != 0) return -1;
+        }
+    }
+    if (side == 0) {
+        clock_gettime(CLOCK_MONOTONIC, &e);
+        p->secs = elapsed_sec(&s, &e) / (2.0 * SWITCH_ROUNDS);
+    }
+    return 0;
+}
+
+static void *pp_peer_thread(void *arg) {
+    struct pingpong *p = arg;
+    if (pp_side(p, 1) != 0) p->failed = 1;
+    return NULL;
+}
+
+/* Seconds per handoff, or -1. The caller plays side 0; its CPU affinity is restored afterwards. */
+static double pingpong(struct pingpong *p, enum switch_peer peer) {
+    cpu_set_t saved;
+    pthread_t tid;
+    pid_t child = -1;
+
+    p->failed = 0;
+    p->word[0] = p->word[1] = 0;
+    if (sched_getaffinity(0, sizeof(saved), &saved) != 0) return -1;
+    if (peer == SWITCH_PROCESSES) {
+        child = fork();
+        if (child < 0) return -1;
+        if (child == 0) _exit(pp_side(p, 1) == 0 ? 0 : 1);
+    } else if (pthread_create(&tid, NULL, pp_peer_thread, p) != 0) {
+        return -1;
+    }
+
+    if (pp_side(p, 0) != 0) {
+        p->failed = 1;
+        if (peer == SWITCH_PROCESSES) kill(child, SIGKILL);
+    }
+    sched_setaffinity(0, sizeof(saved), &saved);
+
+    if (peer == SWITCH_PROCESSES) {
+        int st;
+        if (waitpid(child, &st, 0) != child || !WIFEXITED(st) || WEXITSTATUS(st) != 0) p->failed = 1;
+    } else {
+        pthread_join(tid, NULL);
+    }
+    return p->failed ? -1 : p->secs;
+}
+
+/* The first two CPUs this process may run on; cpu[1] = -1 with only one. */
+static void pick_cpus(int cpu[2]) {
+    cpu_set_t set;
+    cpu[0] = 0;
+    cpu[1] = -1;
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) return;
+
+    int found = 0;
+    for (int k = 0; k < CPU_SETSIZE && found < 2; k++)
+        if (CPU_ISSET(k, &set)) cpu[found++] = k;
+}
+
+int switch_measure(struct switch_calib *out) {
+    struct pingpong p;
+    int cpu[2], rc = -1;
+
+    memset(out, 0, sizeof(*out));
+    memset(&p, 0, sizeof(p));
+    pick_cpus(cpu);
+    p.word = mmap(NULL, 2 * sizeof(uint32_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (p.word == MAP_FAILED) return -1;
+    for (int d = 0; d < 2; d++) p.pipe_fd[d][0] = p.pipe_fd[d][1] = p.event_fd[d] = -1;
+    for (int d = 0; d < 2; d++) {
+        if (pipe(p.pipe_fd[d]) != 0) goto fail;
+        if ((p.event_fd[d] = eventfd(0, 0)) < 0) goto fail;
+    }
+
+    for (int m = 0; m < SWITCH_NMECH; m++) {
+        p.mech = m;
+        for (int peer = 0; peer < SWITCH_NPEER; peer++) {
+            for (int place = 0; place < SWITCH_NPLACE; place++) {
+                p.cpu[0] = cpu[0];
+                p.cpu[1] = (place == SWITCH_SAME_CORE) ? cpu[0] : cpu[1];
+                if (p.cpu[1] < 0) continue;
+                double s = pingpong(&p, peer);
+                if (s < 0) goto fail;
+                out->cost[m][peer][place] = s;
+            }
+        }
+    }
+    rc = 0;
+
+fail:
+    for (int d = 0; d < 2; d++) {
+        if (p.pipe_fd[d][0] >= 0) close(p.pipe_fd[d][0]);
+        if (p.pipe_fd[d][1] >= 0) close(p.pipe_fd[d][1]);
+        if (p.event_fd[d] >= 0) close(p.event_fd[d]);
+    }
+    munmap(p.word, 2 * sizeof(uint32_t));
+    return rc;
+}
+
+/*
+ * What the simulators charge per switch: two processes on one core, so
+ * the address-space switch is included, over the cheapest mechanism,
+ * which adds the least IPC on top of the switch itself.
+ */
+double switch_cost(const struct switch_calib *c) {
+    double best = 0;
+    for (int m = 0; m < SWITCH_NMECH; m++) {
+        double v = c->cost[m][SWITCH_PROCESSES][SWITCH_SAME_CORE];
+        if (v > 0 && (best == 0 || v < best)) best = v;
+    }
+    return best;
+}
+
+// ================= CALIBRATION CACHE =================
+
+/*
+ * One line per host in the swap calibration file: "host switch stamp
+ * version" and the twelve costs. The swap code passes these lines
+ * through untouched and this code passes the disk lines through.
+ */
+#define SWITCH_CACHE_VERSION 1
+#define SWITCH_LINE 8192
+
+static int switch_host(char *host, size_t size) {
+    if (gethostname(host, size) != 0) return -1;
+    host[size - 1] = '\0';
+    for (char *p = host; *p; p++)
+        if (*p == ' ') *p = '_';
+    return 0;
+}
+
+static int is_switch_line(const char *line, const char *host, long *stamp, int *used) {
+    char h[64], kind[16];
+    long st = 0;
+    int n = 0;
+    if (sscanf(line, "%63s %15s %ld%n", h, kind, &st, &n) != 3) return 0;
+    if (strcmp(kind, "switch") != 0 || strcmp(h, host) != 0) return 0;
+    if (stamp) *stamp = st;
+    if (used) *used = n;
+    return 1;
+}
+
+/* Fresh cached costs for this host; -1 if missing or expired. */
+int switch_load(struct switch_calib *out) {
+    char host[64], path[640];
+    if (switch_host(host, sizeof(host)) != 0 || calib_cache_path(path, sizeof(path), 0) != 0) return -1;
+
+    FILE *fp = fopen(path, "r");
+    if (!fp) return -1;
+
+    static char line[SWITCH_LINE];
+    int found = -1;
+    time_t now = time(NULL);
+    while (found != 0 && fgets(line, sizeof(line), fp)) {
+        long stamp;
+        int used, version;
+        if (!is_switch_line(line, host, &stamp, &used)) continue;
+        if (now - stamp > calib_cache_ttl() || now < stamp) continue;
+
+        const char *s = line + used;
+        if (sscanf(s, "%d%n", &version, &used) != 1 || version != SWITCH_CACHE_VERSION) continue;
+        s += used;
+        int ok = 1;
+        double *v = &out->cost[0][0][0];
+        for (int i = 0; ok && i < SWITCH_NMECH * SWITCH_NPEER * SWITCH_NPLACE; i++) {
+            char *end;
+            v[i] = strtod(s, &end);
+            ok = end != s && v[i] >= 0;
+            s = end;
+        }
+        if (ok && switch_cost(out) > 0) found = 0;
+    }
+    fclose(fp);
+    return found;
+}
+
+int switch_store(const struct switch_calib *c) {
+    char host[64], path[640], tmp[700];
+    if (switch_host(host, sizeof(host)) != 0 || calib_cache_path(path, sizeof(path), 1) != 0) return -1;
+
+    snprintf(tmp, sizeof(tmp), "%s.%ld", path, (long)getpid());
+    FILE *out = fopen(tmp, "w");
+    if (!out) return -1;
+
+    FILE *in = fopen(path, "r");
+    if (in) {
+        static char line[SWITCH_LINE];
+        while (fgets(line, sizeof(line), in))
+            if (!is_switch_line(line, host, NULL, NULL)) fputs(line, out);
+        fclose(in);
+    }
+    fprintf(out, "%s switch %ld %d", host, (long)time(NULL), SWITCH_CACHE_VERSION);
+    const double *v = &c->cost[0][0][0];
+    for (int i = 0; i < SWITCH_NMECH * SWITCH_NPEER * SWITCH_NPLACE; i++) fprintf(out, " %.6g", v[i]);
+    fputc('\n', out);
+
+    if (fclose(out) != 0 || rename(tmp, path) != 0) {
+        remove(tmp);
+        return -1;
+    }
+    return 0;
+}
+
+/* The cached costs for this host, measured (and cached) first if need be. */
+int switch_get(struct switch_calib *out) {
+    if (!calib_refresh() && switch_load(out) == 0) return 0;
+    if (switch_measure(out) != 0) return -1;
+    switch_store(out);
+    return 0;
+}
+
+/* Seconds (= simulation units) charged per context switch, 0 if it cannot be measured. */
+double measure_switch_cost(void) {
+    struct switch_calib c;
+    if (switch_get(&c) != 0) return 0;
+    return switch_cost(&c);
+}
@@ -0,0 +1,33 @@
+#ifndef SCHED_SWITCH_H
+#define SCHED_SWITCH_H
+
+// ================= CONTEXT SWITCH COST =================
+
+/*
+ * Ping-pong microbenchmark: two tasks hand a token back and forth, so
+ * every handoff blocks one and wakes the other. It is timed over pipes,
+ * eventfds and bare futexes, between two threads of one process and
+ * between two processes, with both pinned to one core (every handoff is
+ * a full switch) and to two cores (every handoff is a cross-CPU
+ * wakeup). The results are cached per host next to the swap curve;
+ * SCHED_CALIB_CACHE, SCHED_CALIB_TTL and SCHED_RECALIBRATE apply.
+ */
+enum switch_mech { SWITCH_PIPE, SWITCH_EVENTFD, SWITCH_FUTEX, SWITCH_NMECH };
+enum switch_peer { SWITCH_THREADS, SWITCH_PROCESSES, SWITCH_NPEER };
+enum switch_place { SWITCH_SAME_CORE, SWITCH_CROSS_CORE, SWITCH_NPLACE };
+
+extern const char *const switch_mech_names[SWITCH_NMECH];
+
+/* Seconds per handoff; 0 where it could not be measured (one CPU only). */
+struct switch_calib {
+    double cost[SWITCH_NMECH][SWITCH_NPEER][SWITCH_NPLACE];
+};
+
+int    switch_measure(struct switch_calib *out);
+int    switch_load(struct switch_calib *out);
+int    switch_store(const struct switch_calib *c);
+int    switch_get(struct switch_calib *out);
+double switch_cost(const struct switch_calib *c);
+double measure_switch_cost(void);
+
+#endif
@@ -0,0 +1,96 @@
+#define _POSIX_C_SOURCE 200809L
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sched_trace.h"
+
+#define TRACE_IDLE_NS 50000
+
+_Static_assert(sizeof(struct trace_rec) == 32, "trace records are 32 bytes on disk");
+
+// ================= ASYNC WRITER =================
+
+static void *trace_writer(void *arg) {
+    struct sched_trace *t = arg;
+    struct timespec idle = { 0, TRACE_IDLE_NS };
+
+    for (;;) {
+        uint64_t tail = t->tail;
+        uint64_t head = __atomic_load_n(&t->head, __ATOMIC_ACQUIRE);
+
+        if (head == tail) {
+            if (__atomic_load_n(&t->done, __ATOMIC_ACQUIRE) &&
+                __atomic_load_n(&t->head, __ATOMIC_ACQUIRE) == tail)
+                break;
+            nanosleep(&idle, NULL);
+            continue;
+        }
+
+        // Up to the end of the ring in one write; the wrapped part goes next pass
+        uint64_t start = tail & t->mask;
+        uint64_t run = head - tail;
+        if (run > t->mask + 1 - start) run = t->mask + 1 - start;
+        if (!t->failed && fwrite(&t->ring[start], sizeof(struct trace_rec), run, t->file) != run)
+            t->failed = 1;
+        t->written += run;
+        __atomic_store_n(&t->tail, tail + run, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+/* Ring full: let the writer catch up. */
+void trace_wait(struct sched_trace *t) {
+    do {
+        sched_yield();
+        t->tail_cache = __atomic_load_n(&t->tail, __ATOMIC_ACQUIRE);
+    } while (t->head - t->tail_cache > t->mask);
+}
+
+struct sched_trace *trace_open(const char *path, int ncpu) {
+    struct sched_trace *t = aligned_alloc(64, (sizeof(*t) + 63) & ~(size_t)63);
+    if (!t) return NULL;
+    memset(t, 0, sizeof(*t));
+
+    t->mask = (1u << TRACE_RING_BITS) - 1;
+    t->ring = malloc((t->mask + 1) * sizeof(struct trace_rec));
+    t->file = fopen(path, "wb");
+    if (!t->ring || !t->file) goto fail;
+    setvbuf(t->file, NULL, _IOFBF, 1 << 20);
+
+    struct trace_header h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, TRACE_MAGIC, sizeof(h.magic));
+    h.version = TRACE_VERSION;
+    h.endian = TRACE_ENDIAN;
+    h.rec_size = sizeof(struct trace_rec);
+    h.ncpu = ncpu;
+    if (fwrite(&h, sizeof(h), 1, t->file) != 1) goto fail;
+
+    if (pthread_create(&t->writer, NULL, trace_writer, t) != 0) goto fail;
+    return t;
+
+fail:
+    if (t->file) {
+        fclose(t->file);
+        remove(path);
+    }
+    free(t->ring);
+    free(t);
+    return NULL;
+}
+
+/* Drain the ring, stop the writer and close the file; records written, or -1 if any write failed. */
+int64_t trace_close(struct sched_trace *t) {
+    if (!t) return 0;
+
+    __atomic_store_n(&t->done, 1, __ATOMIC_RELEASE);
+    pthread_join(t->writer, NULL);
+
+    int64_t rc = t->failed ? -1 : (int64_t)t->written;
+    if (fclose(t->file) != 0) rc = -1;
+    free(t->ring);
+    free(t);
+    return rc;
+}
@@ -0,0 +1,95 @@
+#ifndef SCHED_TRACE_H
+#define SCHED_TRACE_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// ================= BINARY EVENT LOG =================
+
+/*
+ * Fixed-size little-endian records behind a small header. What `len`
+ * holds depends on the record type (see enum trace_type). `queued` is
+ * the length of the CPU's run queue just after the event.
+ */
+#define TRACE_MAGIC "SCHEDEVT"
+#define TRACE_VERSION 1
+#define TRACE_ENDIAN 0x01020304u
+
+enum trace_type {
+    TR_DISPATCH,    // len = slice granted
+    TR_PREEMPT,     // len = burst still to run
+    TR_COMPLETE,    // len = turnaround time
+    TR_SWAP,        // len = swap-in penalty charged before the slice
+    TR_ARRIVAL,     // len = burst time
+    TR_NTYPES
+};
+
+struct trace_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;    // TRACE_ENDIAN as the producer stored it
+    uint32_t rec_size;
+    uint32_t ncpu;
+};
+
+struct trace_rec {
+    double time;
+    double len;
+    int32_t pid;
+    int32_t queued;
+    uint16_t cpu;
+    uint16_t type;
+    uint32_t reserved;
+};
+
+// ================= ASYNC WRITER =================
+
+/*
+ * Single-producer single-consumer ring between the simulation and a
+ * writer thread. The producer only touches its own head and a cached
+ * copy of the tail, so emitting a record is a store plus a release of
+ * the head; the writer drains whole runs of the ring with one fwrite.
+ * Nothing is dropped: a producer that laps the writer waits for it.
+ */
+#define TRACE_RING_BITS 16
+
+struct sched_trace {
+    struct trace_rec *ring;
+    uint64_t mask;
+
+    _Alignas(64) uint64_t head;     // written by the producer only
+    uint64_t tail_cache;
+    _Alignas(64) uint64_t tail;     // written by the writer only
+    int done;
+    int failed;
+
+    FILE *file;
+    uint64_t written;
+    pthread_t writer;
+};
+
+struct sched_trace *trace_open(const char *path, int ncpu);
+int64_t trace_close(struct sched_trace *t);
+void    trace_wait(struct sched_trace *t);
+
+static inline void trace_emit(struct sched_trace *t, int type, int cpu, int pid,
+                              double time, double len, int queued) {
+    uint64_t h = t->head;
+    if (h - t->tail_cache > t->mask) {
+        t->tail_cache = __atomic_load_n(&t->tail, __ATOMIC_ACQUIRE);
+        if (h - t->tail_cache > t->mask) trace_wait(t);
+    }
+
+    struct trace_rec *r = &t->ring[h & t->mask];
+    r->time = time;
+    r->len = len;
+    r->pid = pid;
+    r->queued = queued;
+    r->cpu = (uint16_t)cpu;
+    r->type = (uint16_t)type;
+    r->reserved = 0;
+    __atomic_store_n(&t->head, h + 1, __ATOMIC_RELEASE);
+}
+
+#endif
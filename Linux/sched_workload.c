@@ -0,0 +1,399 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "sched_rand.h"
+#include "sched_workload.h"
+
+#define WL_ENDIAN 0x01020304u
+#define WL_CSV_MAX_FIELDS 16
+
+_Static_assert(sizeof(int) == 4, ".wl int32 columns are mapped as int");
+
+// ================= WORKLOAD =================
+
+int workload_alloc(struct workload *wl, int n) {
+    memset(wl, 0, sizeof(*wl));
+    if (n <= 0) return -1;
+
+    wl->pid = malloc((size_t)n * sizeof(int));
+    wl->at = malloc((size_t)n * sizeof(double));
+    wl->bt = malloc((size_t)n * sizeof(double));
+    wl->priority = malloc((size_t)n * sizeof(int));
+    if (!wl->pid || !wl->at || !wl->bt || !wl->priority) {
+        workload_free(wl);
+        return -1;
+    }
+    wl->n = n;
+    return 0;
+}
+
+void workload_free(struct workload *wl) {
+    if (wl->map) {
+        munmap(wl->map, wl->map_len);
+    } else {
+        free(wl->pid);
+        free(wl->at);
+        free(wl->bt);
+        free(wl->priority);
+        free(wl->mem_mb);
+        free(wl->nice);
+    }
+    memset(wl, 0, sizeof(*wl));
+}
+
+void workload_generate(struct workload *wl, uint64_t seed, uint64_t stream) {
+    struct sched_rng r;
+    rng_init(&r, seed, stream);
+
+    for (int i = 0; i < wl->n; i++) {
+        wl->pid[i] = i + 1;
+        wl->at[i] = rng_below(&r, 5) + 1;
+        wl->bt[i] = rng_below(&r, 8) + 2;
+        wl->priority[i] = rng_below(&r, 5) + 1; // 1=highest, 5=lowest
+        if (wl->nice) wl->nice[i] = (int)rng_below(&r, 11) - 5;
+        if (wl->mem_mb) wl->mem_mb[i] = 16.0 * (rng_below(&r, 16) + 1);
+    }
+}
+
+/* Times every policy can run with: finite, AT and BT not negative. */
+static int times_ok(double at, double bt) {
+    return isfinite(at) && isfinite(bt) && at >= 0 && bt >= 0;
+}
+
+static int workload_fill(struct workload *wl, int choice, enum workload_extra extra) {
+    if (extra == WL_INPUT_NICE && !(wl->nice = calloc(wl->n, sizeof(int)))) return -1;
+
+    if (choice != 1) {
+        workload_generate(wl, (uint64_t)time(NULL), 0);
+        if (extra != WL_INPUT_PRIORITY)
+            for (int i = 0; i < wl->n; i++) wl->priority[i] = 0;
+        return 0;
+    }
+
+    for (int i = 0; i < wl->n; i++) {
+        int got, want = 3;
+        wl->pid[i] = i + 1;
+        wl->priority[i] = 0;
+        if (extra == WL_INPUT_PRIORITY) {
+            printf("Enter AT, BT and Priority for P%d: ", wl->pid[i]);
+            got = scanf("%lf %lf %d", &wl->at[i], &wl->bt[i], &wl->priority[i]);
+        } else if (extra == WL_INPUT_NICE) {
+            printf("Enter AT, BT and Nice for P%d: ", wl->pid[i]);
+            got = scanf("%lf %lf %d", &wl->at[i], &wl->bt[i], &wl->nice[i]);
+        } else {
+            printf("Enter AT and BT for P%d: ", wl->pid[i]);
+            got = scanf("%lf %lf", &wl->at[i], &wl->bt[i]);
+            want = 2;
+        }
+        if (got != want || !times_ok(wl->at[i], wl->bt[i])) {
+            fprintf(stderr, "Invalid input for P%d: AT and BT must be finite and not negative\n",
+                    wl->pid[i]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int workload_read(struct workload *wl, enum workload_extra extra) {
+    return workload_read_ask(wl, extra, NULL, NULL);
+}
+
+int workload_read_ask(struct workload *wl, enum workload_extra extra,
+                      int (*ask)(void *arg), void *arg) {
+    int choice = 2, n = 0;
+
+    printf("1. Manual Input\n2. Automated Input\n3. Workload File (.wl)\nEnter choice: ");
+    if (scanf("%d", &choice) != 1) return -1;
+
+    if (choice == 3) {
+        char path[4096];
+        printf("Enter workload file: ");
+        if (scanf("%4095s", path) != 1) return -1;
+        if (workload_map(wl, path) != 0) {
+            fprintf(stderr, "Cannot load workload file %s\n", path);
+            return -1;
+        }
+        printf("Loaded %d processes from %s\n", wl->n, path);
+        if (ask && ask(arg) != 0) {
+            workload_free(wl);
+            return -1;
+        }
+        return 0;
+    }
+
+    printf("Enter number of processes: ");
+    if (scanf("%d", &n) != 1 || workload_alloc(wl, n) != 0) {
+        fprintf(stderr, "Invalid number of processes\n");
+        return -1;
+    }
+    if ((ask && ask(arg) != 0) || workload_fill(wl, choice, extra) != 0) {
+        workload_free(wl);
+        return -1;
+    }
+    return 0;
+}
+
+// ================= BINARY .wl FORMAT =================
+
+/*
+ * Let a mapped workload be edited in place. The mapping is private, so
+ * written pages become copy-on-write copies and the file is untouched.
+ */
+int workload_writable(struct workload *wl) {
+    if (!wl->map) return 0;
+    return mprotect(wl->map, wl->map_len, PROT_READ | PROT_WRITE);
+}
+
+size_t wl_col_size(enum wl_column col) {
+    switch (col) {
+    case WL_COL_AT:
+    case WL_COL_BT:
+    case WL_COL_MEM:
+        return sizeof(double);
+    default:
+        return sizeof(int);
+    }
+}
+
+/* Map a .wl file; the columns are used in place, only AT and BT are checked. */
+int workload_map(struct workload *wl, const char *path) {
+    memset(wl, 0, sizeof(*wl));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    struct stat sb;
+    if (fstat(fd, &sb) != 0 || (size_t)sb.st_size < sizeof(struct wl_header)) {
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+
+    const struct wl_header *h = map;
+    size_t len = sb.st_size;
+    if (memcmp(h->magic, WL_MAGIC, sizeof(WL_MAGIC)) != 0 ||
+        h->version != WL_VERSION || h->endian != WL_ENDIAN ||
+        h->n == 0 || h->n > 0x7fffffff)
+        goto bad;
+
+    void *cols[WL_NCOLS];
+    for (int c = 0; c < WL_NCOLS; c++) {
+        uint64_t off = h->col_off[c];
+        cols[c] = NULL;
+        if (off == 0) {
+            if (c <= WL_COL_PRIORITY) goto bad;
+            continue;
+        }
+        if (off % 8 != 0 || off > len || h->n * wl_col_size(c) > len - off)
+            goto bad;
+        cols[c] = (char *)map + off;
+    }
+
+    /* Times must be usable by every policy: finite, AT and BT not negative. */
+    const double *at = cols[WL_COL_AT], *bt = cols[WL_COL_BT];
+    for (uint64_t i = 0; i < h->n; i++)
+        if (!times_ok(at[i], bt[i])) goto bad;
+
+    wl->n = (int)h->n;
+    wl->pid = cols[WL_COL_PID];
+    wl->at = cols[WL_COL_AT];
+    wl->bt = cols[WL_COL_BT];
+    wl->priority = cols[WL_COL_PRIORITY];
+    wl->mem_mb = cols[WL_COL_MEM];
+    wl->nice = cols[WL_COL_NICE];
+    wl->map = map;
+    wl->map_len = len;
+    return 0;
+
+bad:
+    munmap(map, len);
+    return -1;
+}
+
+// ================= CSV IMPORT =================
+
+static const char *col_names[WL_NCOLS] = {
+    "pid", "at", "bt", "priority", "mem", "nice"
+};
+
+static int col_by_name(const char *s, size_t len) {
+    for (int c = 0; c < WL_NCOLS; c++)
+        if (strlen(col_names[c]) == len && strncasecmp(s, col_names[c], len) == 0)
+            return c;
+    if (len == 7 && strncasecmp(s, "arrival", len) == 0) return WL_COL_AT;
+    if (len == 5 && strncasecmp(s, "burst", len) == 0) return WL_COL_BT;
+    return -1;
+}
+
+static int copy_column(FILE *out, FILE *tmp) {
+    char buf[1 << 16];
+    size_t got;
+    rewind(tmp);
+    while ((got = fread(buf, 1, sizeof(buf), tmp)) > 0)
+        if (fwrite(buf, 1, got, out) != got) return -1;
+    return ferror(tmp) ? -1 : 0;
+}
+
+/*
+ * Rows are streamed into one temporary file per column so memory use
+ * does not depend on the trace length; the columns are concatenated
+ * behind the header once the row count is known. The first line may
+ * name the columns (pid,at,bt,priority,mem,nice in any order);
+ * without it rows are read as pid,at,bt[,priority]. Missing pid
+ * defaults to the row number, missing priority to 0.
+ */
+long workload_import_csv(FILE *in, const char *out_path) {
+    int map[WL_CSV_MAX_FIELDS] = { WL_COL_PID, WL_COL_AT, WL_COL_BT, WL_COL_PRIORITY };
+    int nfields = 4;
+    int present[WL_NCOLS] = { 1, 1, 1, 1, 0, 0 };
+    FILE *tmp[WL_NCOLS] = { 0 };
+    FILE *out = NULL;
+    static const char pad[8];
+    char *line = NULL;
+    size_t cap = 0;
+    long n = 0, lineno = 0;
+    int header_seen = 0;
+
+    while (getline(&line, &cap, in) != -1) {
+        lineno++;
+        char *s = line;
+        while (isspace((unsigned char)*s)) s++;
+        if (*s == '\0' || *s == '#') continue;
+
+        if (!header_seen) {
+            header_seen = 1;
+            if (isalpha((unsigned char)*s)) {
+                memset(present, 0, sizeof(present));
+                nfields = 0;
+                while (*s && nfields < WL_CSV_MAX_FIELDS) {
+                    char *e = s;
+                    while (*e && *e != ',' && !isspace((unsigned char)*e)) e++;
+                    int c = col_by_name(s, e - s);
+                    map[nfields++] = c;
+                    if (c >= 0) present[c] = 1;
+                    while (*e == ',' || isspace((unsigned char)*e)) e++;
+                    s = e;
+                }
+                if (!present[WL_COL_AT] || !present[WL_COL_BT]) {
+                    fprintf(stderr, "CSV header needs at least at and bt columns\n");
+                    goto fail;
+                }
+                present[WL_COL_PID] = present[WL_COL_PRIORITY] = 1;
+                continue;
+            }
+        }
+
+        for (int c = 0; c < WL_NCOLS; c++)
+            if (present[c] && !tmp[c] && !(tmp[c] = tmpfile())) goto fail;
+
+        double dv[WL_NCOLS] = { 0 };
+        int iv[WL_NCOLS] = { 0 };
+        int got[WL_NCOLS] = { 0 };
+        iv[WL_COL_PID] = (int)(n + 1);
+
+        for (int f = 0; f < nfields; f++) {
+            size_t len = strcspn(s, ",\r\n");
+            int c = map[f];
+            if (c >= 0 && len > 0) {
+                char *e;
+                int range_ok = 1;
+                errno = 0;
+                if (wl_col_size(c) == sizeof(double)) {
+                    dv[c] = strtod(s, &e);
+                } else {
+                    long v = strtol(s, &e, 10);
+                    range_ok = errno != ERANGE && v >= INT_MIN && v <= INT_MAX;
+                    iv[c] = (int)v;
+                }
+                /* The number must be the whole field, give or take trailing blanks. */
+                while (e < s + len && (*e == ' ' || *e == '\t')) e++;
+                if (e == s || e != s + len || !range_ok) {
+                    fprintf(stderr, "CSV line %ld: bad field %d\n", lineno, f + 1);
+                    goto fail;
+                }
+                got[c] = 1;
+            }
+            s += len;
+            if (*s != ',') break;
+            s++;
+        }
+        if (!got[WL_COL_AT] || !got[WL_COL_BT]) {
+            fprintf(stderr, "CSV line %ld: missing arrival or burst\n", lineno);
+            goto fail;
+        }
+        if (!times_ok(dv[WL_COL_AT], dv[WL_COL_BT])) {
+            fprintf(stderr, "CSV line %ld: arrival and burst must be finite and not negative\n", lineno);
+            goto fail;
+        }
+
+        for (int c = 0; c < WL_NCOLS; c++) {
+            if (!present[c]) continue;
+            const void *v = (wl_col_size(c) == sizeof(double)) ? (const void *)&dv[c]
+                                                              : (const void *)&iv[c];
+            if (fwrite(v, wl_col_size(c), 1, tmp[c]) != 1) goto fail;
+        }
+        n++;
+    }
+
+    if (n == 0 || n > 0x7fffffff) {
+        fprintf(stderr, "CSV has no usable rows\n");
+        goto fail;
+    }
+
+    struct wl_header h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, WL_MAGIC, sizeof(WL_MAGIC));
+    h.version = WL_VERSION;
+    h.endian = WL_ENDIAN;
+    h.n = n;
+
+    uint64_t off = sizeof(h);
+    for (int c = 0; c < WL_NCOLS; c++) {
+        if (!present[c]) continue;
+        off = (off + 7) & ~(uint64_t)7;
+        h.col_off[c] = off;
+        off += n * wl_col_size(c);
+    }
+
+    out = fopen(out_path, "wb");
+    if (!out || fwrite(&h, sizeof(h), 1, out) != 1) goto fail;
+    for (int c = 0; c < WL_NCOLS; c++) {
+        if (!present[c]) continue;
+        size_t gap = h.col_off[c] - (uint64_t)ftell(out);
+        if (fwrite(pad, 1, gap, out) != gap) goto fail;
+        if (copy_column(out, tmp[c]) != 0) goto fail;
+    }
+    if (fclose(out) != 0) {
+        out = NULL;
+        goto fail;
+    }
+    for (int c = 0; c < WL_NCOLS; c++)
+        if (tmp[c]) fclose(tmp[c]);
+    free(line);
+    return n;
+
+fail:
+    if (out) {
+        fclose(out);
+        remove(out_path);
+    }
+    for (int c = 0; c < WL_NCOLS; c++)
+        if (tmp[c]) fclose(tmp[c]);
+    free(line);
+    return -1;
+}
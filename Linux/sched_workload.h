@@ -0,0 +1,90 @@
+#ifndef SCHED_WORKLOAD_H
+#define SCHED_WORKLOAD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// ================= WORKLOAD =================
+
+/*
+ * Read-only job description shared by every policy. The columns either
+ * come from malloc (interactive input) or point straight into a mapped
+ * .wl file. Optional columns are NULL when the workload has none.
+ */
+struct workload {
+    int n;
+    int *pid;
+    double *at, *bt;
+    int *priority;
+    double *mem_mb;
+    int *nice;
+
+    void *map;
+    size_t map_len;
+};
+
+int  workload_alloc(struct workload *wl, int n);
+void workload_free(struct workload *wl);
+
+/* Which per-job field, besides AT and BT, the interactive input asks for. */
+enum workload_extra { WL_INPUT_BASIC, WL_INPUT_PRIORITY, WL_INPUT_NICE };
+
+/* Interactive input used by the scheduler binaries (manual, random or file). */
+int  workload_read(struct workload *wl, enum workload_extra extra);
+
+/*
+ * The same, calling ask(arg) once the job count is known (after the
+ * number of processes, or after the file loads) for a driver prompt
+ * that comes before the per-job lines. A non-zero return aborts.
+ */
+int  workload_read_ask(struct workload *wl, enum workload_extra extra,
+                       int (*ask)(void *arg), void *arg);
+
+/*
+ * Fill an allocated workload with the "Automated Input" distribution
+ * (AT 1..5, BT 2..9, priority 1..5, nice -5..5 and memory 16..256 MB
+ * when those columns exist),
+ * drawn from random stream `stream` of `seed`.
+ */
+void workload_generate(struct workload *wl, uint64_t seed, uint64_t stream);
+
+// ================= BINARY .wl FORMAT =================
+
+/*
+ * Little-endian, column oriented: a fixed header followed by one array
+ * per column, each starting on an 8-byte boundary. col_off[] holds the
+ * byte offset of every column from the start of the file, 0 for an
+ * optional column that is absent. Required columns are PID (int32),
+ * AT and BT (float64) and PRIORITY (int32).
+ */
+#define WL_MAGIC "SCHEDWL"
+#define WL_VERSION 1
+
+enum wl_column {
+    WL_COL_PID,
+    WL_COL_AT,
+    WL_COL_BT,
+    WL_COL_PRIORITY,
+    WL_COL_MEM,     // float64 resident size in MB
+    WL_COL_NICE,    // int32 nice value, -20..19
+    WL_NCOLS
+};
+
+struct wl_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;    // 0x01020304 as written by the producer
+    uint64_t n;
+    uint64_t col_off[WL_NCOLS];
+};
+
+size_t wl_col_size(enum wl_column col);
+
+int workload_map(struct workload *wl, const char *path);
+int workload_writable(struct workload *wl);
+
+/* Streaming CSV -> .wl conversion; returns the job count or -1. */
+long workload_import_csv(FILE *in, const char *out_path);
+
+#endif
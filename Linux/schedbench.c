@@ -0,0 +1,169 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "sched_engine.h"
+
+/*
+ * Dispatch throughput against job count. Jobs arrive two per time unit
+ * with bursts of 2..9, so the ready queue keeps growing and every pick
+ * happens against a queue of O(n) jobs.
+ */
+static void make_workload(struct workload *wl, unsigned seed) {
+    srand(seed);
+    for (int i = 0; i < wl->n; i++) {
+        wl->pid[i] = i + 1;
+        wl->at[i] = i / 2;
+        wl->bt[i] = (rand() % 8) + 2;
+        wl->priority[i] = (rand() % 5) + 1;
+    }
+}
+
+// ================= FCFS SCAN PARITY =================
+
+/*
+ * `schedbench check [max_n]`: FCFS on the parallel scan must give the
+ * event loop's results bit for bit. Every trace shape is run with
+ * threads = -1 and with 1..16 workers, with and without the swap
+ * penalty, and the result columns, completion order and sums compared.
+ */
+static const char *const shapes[] = {
+    "sorted", "shuffled", "saturated", "sparse", "negative", "zero-burst", NULL
+};
+
+static void make_shape(struct workload *wl, int shape, unsigned seed) {
+    double t = 0;
+    srand(seed);
+    for (int i = 0; i < wl->n; i++) {
+        double u = rand() / (RAND_MAX + 1.0);
+        wl->pid[i] = i + 1;
+        wl->priority[i] = 1;
+        switch (shape) {
+        case 0: t += u * 12; wl->at[i] = t; wl->bt[i] = (rand() % 90) / 10.0 + 0.1; break;
+        case 1: wl->at[i] = (int)(u * wl->n); wl->bt[i] = (rand() % 8) + 2; break;
+        case 2: wl->at[i] = i / 2; wl->bt[i] = (rand() % 8) + 2; break;
+        case 3: wl->at[i] = u * wl->n * 8; wl->bt[i] = (rand() % 60) / 10.0; break;
+        case 4: wl->at[i] = (i % 3 == 0) ? -0.0 : (i % 3 == 1) ? 0.0 : -u * 3; wl->bt[i] = 1; break;
+        default: t += (i % 1000 == 0) ? 1e4 : 0.3; wl->at[i] = t; wl->bt[i] = (i % 7) * 0.25; break;
+        }
+    }
+}
+
+static int same_run(const struct sched_ctx *a, const struct sched_ctx *b) {
+    size_t d = (size_t)a->wl->n * sizeof(double);
+    return memcmp(a->p.st, b->p.st, d) == 0 && memcmp(a->p.ft, b->p.ft, d) == 0 &&
+           memcmp(a->p.wt, b->p.wt, d) == 0 && memcmp(a->p.tat, b->p.tat, d) == 0 &&
+           memcmp(a->p.rt, b->p.rt, d) == 0 &&
+           memcmp(a->done_order, b->done_order, (size_t)a->wl->n * sizeof(int)) == 0 &&
+           a->stats.total_wt == b->stats.total_wt && a->stats.total_tat == b->stats.total_tat &&
+           a->stats.total_rt == b->stats.total_rt && a->stats.total_swaps == b->stats.total_swaps &&
+           a->stats.max_ft == b->stats.max_ft && a->cpu[0].max_queued == b->cpu[0].max_queued;
+}
+
+static int check_scan(int max_n) {
+    static const int workers[] = { 1, 2, 4, 8, 16 };
+    int failures = 0;
+
+    printf("CampusConnect FCFS Scan Parity (event loop against 1..16 workers)\n");
+    printf("+------------+------------+--------+------------------+------------------+---------+\n");
+    printf("|   Trace    |     n      |  Swap  | Event loop (sec) | 16 workers (sec) | Result  |\n");
+    printf("+------------+------------+--------+------------------+------------------+---------+\n");
+    for (int shape = 0; shapes[shape]; shape++) {
+        for (int n = 1000; n <= max_n; n *= 10) {
+            struct workload wl;
+            if (workload_alloc(&wl, n) != 0) return -1;
+            make_shape(&wl, shape, 42);
+
+            for (int w = 0; w < 2; w++) {
+                struct sched_config cfg = { .swap_time = w ? 0.5 : 0, .threads = -1 };
+                struct sched_ctx ref, ctx;
+                int ok = 1;
+                double scan_time = 0;
+
+                if (sched_init(&ref, &wl, &sched_fcfs, &cfg) != 0 || sched_run(&ref) != 0) {
+                    workload_free(&wl);
+                    return -1;
+                }
+                for (size_t k = 0; k < sizeof(workers) / sizeof(workers[0]); k++) {
+                    cfg.threads = workers[k];
+                    if (sched_init(&ctx, &wl, &sched_fcfs, &cfg) != 0 || sched_run(&ctx) != 0) {
+                        sched_free(&ref);
+                        workload_free(&wl);
+                        return -1;
+                    }
+                    ok = ok && same_run(&ref, &ctx);
+                    scan_time = ctx.stats.exec_time;
+                    sched_free(&ctx);
+                }
+                printf("| %-10s | %-10d | %-6s | %-16.4f | %-16.4f | %-7s |\n", shapes[shape], n,
+                       w ? "on" : "off", ref.stats.exec_time, scan_time, ok ? "same" : "DIFFERS");
+                failures += !ok;
+                sched_free(&ref);
+            }
+            workload_free(&wl);
+        }
+    }
+    printf("+------------+------------+--------+------------------+------------------+---------+\n");
+    return failures;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "check") == 0) {
+        int failures = check_scan((argc > 2) ? atoi(argv[2]) : 1000000);
+        if (failures < 0) fprintf(stderr, "Out of memory\n");
+        return failures != 0;
+    }
+
+    int max_n = (argc > 1) ? atoi(argv[1]) : 10000000;
+    const struct sched_policy *only = NULL;
+    struct sched_config cfg = { .quantum = 4 };
+
+    if (argc > 2 && !(only = sched_policy_by_name(argv[2]))) {
+        fprintf(stderr, "Unknown policy %s\n", argv[2]);
+        return 1;
+    }
+    if (!only) only = &sched_sjf;
+    if (argc > 3) cfg.ncpu = atoi(argv[3]);
+    if (argc > 4) {
+        int b = 0;
+        while (sched_balance_names[b] && strcasecmp(sched_balance_names[b], argv[4]) != 0) b++;
+        if (!sched_balance_names[b]) {
+            fprintf(stderr, "Unknown balancing %s\n", argv[4]);
+            return 1;
+        }
+        cfg.balance = (enum sched_balance)b;
+    }
+    if (argc > 5) cfg.threads = atoi(argv[5]);
+
+    printf("CampusConnect Scheduler Benchmark: %s", only->name);
+    if (cfg.ncpu > 1) printf(" on %d CPUs, %s balancing", cfg.ncpu, sched_balance_names[cfg.balance]);
+    printf("\n");
+    printf("+------------+--------------+-------------+------------------+\n");
+    printf("|     n      |  Dispatches  |  Run (sec)  |  Decisions/sec   |\n");
+    printf("+------------+--------------+-------------+------------------+\n");
+
+    for (int n = 1000; n <= max_n; n *= 10) {
+        struct workload wl;
+        struct sched_ctx ctx;
+
+        if (workload_alloc(&wl, n) != 0) break;
+        make_workload(&wl, 42);
+        if (sched_init(&ctx, &wl, only, &cfg) != 0) {
+            workload_free(&wl);
+            break;
+        }
+        sched_run(&ctx);
+
+        printf("| %-10d | %-12ld | %-11.4f | %-16.0f |\n",
+               n, ctx.stats.dispatches, ctx.stats.exec_time,
+               ctx.stats.dispatches / ctx.stats.exec_time);
+
+        sched_free(&ctx);
+        workload_free(&wl);
+    }
+
+    printf("+------------+--------------+-------------+------------------+\n");
+    return 0;
+}
@@ -0,0 +1,69 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sched_calib.h"
+
+// ================= STORAGE CALIBRATION =================
+
+/*
+ * Runs the storage sweep behind the simulators' swap cost in the
+ * current directory, refreshes the cache entry for this disk and prints
+ * the latency/bandwidth curve. With -c it only shows the cached curve.
+ */
+static void print_curve(const struct swap_calib *c) {
+    const char *rule = "+---------+-----+--------------+--------------+--------------+--------------+\n";
+
+    printf("I/O Engine: %s, %s\n", c->engine == CALIB_IO_URING ? "io_uring" : "pread/pwrite",
+           c->direct ? "O_DIRECT" : "buffered (O_DIRECT refused), page cache dropped before reads");
+    printf("%s", rule);
+    printf("|  Block  | QD  | Write Lat us | Write MB/s   | Read Lat us  | Read MB/s    |\n");
+    printf("%s", rule);
+    for (int b = 0; b < CALIB_NBLOCKS; b++) {
+        for (int d = 0; d < CALIB_NDEPTHS; d++) {
+            const struct calib_point *pt = &c->pt[b][d];
+            printf("| %5d K | %-3d | %-12.1f | %-12.1f | %-12.1f | %-12.1f |\n",
+                   (1 << (CALIB_MIN_BLOCK_SHIFT + b)) >> 10, calib_depths[d],
+                   pt->write_lat * 1e6, pt->write_bw, pt->read_lat * 1e6, pt->read_bw);
+        }
+    }
+    printf("%s", rule);
+
+    printf("Swap Cost (out + in):\n");
+    for (int mb = 1; mb <= 256; mb *= 4)
+        printf("  %4d MB resident         : %.6f units\n", mb, calib_swap_cost(c, (double)mb * (1 << 20)));
+}
+
+int main(int argc, char **argv) {
+    int cached = 0, opt;
+    struct swap_calib c;
+
+    while ((opt = getopt(argc, argv, "c")) != -1) {
+        if (opt != 'c') {
+            fprintf(stderr, "Usage: %s [-c]\n", argv[0]);
+            return 1;
+        }
+        cached = 1;
+    }
+
+    printf("CampusConnect Storage Calibration (Linux)\n");
+    if (cached) {
+        if (calib_load(&c) != 0) {
+            fprintf(stderr, "No fresh calibration cached for this disk\n");
+            return 1;
+        }
+    } else {
+        struct timespec s, e;
+        clock_gettime(CLOCK_MONOTONIC, &s);
+        if (calib_measure(&c) != 0) {
+            perror("Calibration failed");
+            return 1;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &e);
+        printf("Sweep Time: %.3f seconds\n", elapsed_sec(&s, &e));
+        if (calib_store(&c) != 0) fprintf(stderr, "Could not update the calibration cache\n");
+    }
+    print_curve(&c);
+    return 0;
+}
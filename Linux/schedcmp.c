@@ -0,0 +1,211 @@
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "sched_engine.h"
+
+// ================= HEADLESS POLICY COMPARISON =================
+
+/*
+ * Loads or generates one workload and runs every requested policy over
+ * it, each in its own thread. The job table is shared read-only (a
+ * mapped .wl file is never even copied), and every run gets the same
+ * swap time, so the columns differ only by policy.
+ */
+#define CMP_MAX_RUNS 32
+
+struct cmp_run {
+    const struct sched_policy *policy;
+    struct sched_config cfg;
+    char label[24];
+    const struct workload *wl;
+    struct sched_ctx ctx;
+    pthread_t tid;
+    int rc;
+};
+
+static void *cmp_worker(void *arg) {
+    struct cmp_run *r = arg;
+    r->rc = sched_init(&r->ctx, r->wl, r->policy, &r->cfg);
+    if (r->rc == 0) r->rc = sched_run(&r->ctx);
+    return NULL;
+}
+
+static int add_run(struct cmp_run *runs, int *nrun, const struct sched_policy *p,
+                   const struct sched_config *cfg) {
+    if (*nrun == CMP_MAX_RUNS) return -1;
+
+    struct cmp_run *r = &runs[(*nrun)++];
+    memset(r, 0, sizeof(*r));
+    r->policy = p;
+    r->cfg = *cfg;
+    if (p == &sched_rr || p == &sched_mlfq)
+        snprintf(r->label, sizeof(r->label), "%s (q=%g)", p->name, cfg->quantum);
+    else
+        snprintf(r->label, sizeof(r->label), "%s", p->name);
+    return 0;
+}
+
+/* One run per policy; RR and MLFQ once per quantum. */
+static int plan_runs(struct cmp_run *runs, int *nrun, char *policies, char *quanta,
+                     const struct sched_config *base) {
+    double q[CMP_MAX_RUNS];
+    int nq = 0;
+
+    for (char *tok = strtok(quanta, ","); tok && nq < CMP_MAX_RUNS; tok = strtok(NULL, ","))
+        if ((q[nq] = atof(tok)) > 0) nq++;
+    if (nq == 0) q[nq++] = SCHED_DEFAULT_QUANTUM;
+
+    for (char *tok = strtok(policies, ","); tok; tok = strtok(NULL, ",")) {
+        const struct sched_policy *p = sched_policy_by_name(tok);
+        if (!p) {
+            fprintf(stderr, "Unknown policy %s\n", tok);
+            return -1;
+        }
+        struct sched_config cfg = *base;
+        int reps = (p == &sched_rr || p == &sched_mlfq) ? nq : 1;
+        for (int i = 0; i < reps; i++) {
+            cfg.quantum = q[i];
+            if (add_run(runs, nrun, p, &cfg) != 0) {
+                fprintf(stderr, "At most %d runs\n", CMP_MAX_RUNS);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static void print_comparison(const struct cmp_run *runs, int nrun) {
+    const char *rule =
+        "+------------------+------------+------------+------------+------------+------------+------------+------------+-------------+------------+\n";
+    int best = 0;
+
+    printf("\n%s", rule);
+    printf("| Policy           |   Avg WT   |  Avg TAT   |   Avg RT   |   P99 WT   |   Max WT   | Throughput | Dispatches | Preemptions | Swap Stall |\n");
+    printf("%s", rule);
+    for (int i = 0; i < nrun; i++) {
+        const struct sched_ctx *c = &runs[i].ctx;
+        const struct sched_stats *s = &c->stats;
+        int n = c->wl->n;
+
+        printf("| %-16s | %-10.2f | %-10.2f | %-10.2f | %-10.2f | %-10.2f | %-10.4f | %-10ld | %-11ld | %-10.4f |\n",
+               runs[i].label, s->total_wt / n, s->total_tat / n, s->total_rt / n,
+               hist_quantile(&c->hist[METRIC_WT], 0.99), s->max_wt,
+               (double)n / s->max_ft, s->dispatches, s->preemptions, s->swap_stall);
+        if (s->total_wt < runs[best].ctx.stats.total_wt) best = i;
+    }
+    printf("%s", rule);
+    printf("Lowest Average Waiting Time: %s\n", runs[best].label);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-p policy[,policy...]] [-q quantum[,quantum...]] [-w swap_time | -m memory_mb]\n"
+            "          [-x switch_cost] (<workload.wl> | -n jobs [-s seed])\n", prog);
+}
+
+int main(int argc, char **argv) {
+    char policies[256] = "fcfs,sjf,rr,priority";
+    char quanta[256] = "2,4,8";
+    struct sched_config base = { .swap_time = -1, .switch_cost = -1 };
+    struct cmp_run runs[CMP_MAX_RUNS];
+    struct workload wl;
+    int nrun = 0, jobs = 0, opt;
+    uint64_t seed = 1;
+
+    while ((opt = getopt(argc, argv, "p:q:w:m:x:n:s:")) != -1) {
+        switch (opt) {
+        case 'p': snprintf(policies, sizeof(policies), "%s", optarg); break;
+        case 'q': snprintf(quanta, sizeof(quanta), "%s", optarg); break;
+        case 'w': base.swap_time = atof(optarg); break;
+        case 'm': base.mem_mb = atof(optarg); break;
+        case 'x': base.switch_cost = atof(optarg); break;
+        case 'n': jobs = atoi(optarg); break;
+        case 's': seed = strtoull(optarg, NULL, 0); break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if ((optind < argc) == (jobs > 0)) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (plan_runs(runs, &nrun, policies, quanta, &base) != 0) return 1;
+
+    if (optind < argc) {
+        if (workload_map(&wl, argv[optind]) != 0) {
+            fprintf(stderr, "Cannot load workload file %s\n", argv[optind]);
+            return 1;
+        }
+    } else if (workload_alloc(&wl, jobs) != 0 || !(wl.nice = calloc(jobs, sizeof(int))) ||
+               (base.mem_mb > 0 && !(wl.mem_mb = calloc(jobs, sizeof(double))))) {
+        fprintf(stderr, "Out of memory for %d processes\n", jobs);
+        return 1;
+    } else {
+        workload_generate(&wl, seed, 0);
+    }
+
+    double swap = 0;
+    if (base.mem_mb > 0) {
+        // One calibration shared by every run
+        struct swap_calib cal;
+        if (calib_get(&cal) == 0) calib_swap_model(&cal, &base.swap_dev);
+        for (int i = 0; i < nrun; i++) runs[i].cfg.swap_dev = base.swap_dev;
+    } else {
+        swap = (base.swap_time >= 0) ? base.swap_time : measure_hardware_swap();
+    }
+    if (base.switch_cost < 0) base.switch_cost = measure_switch_cost();
+    for (int i = 0; i < nrun; i++) runs[i].cfg.switch_cost = base.switch_cost;
+    printf("CampusConnect Policy Comparison (Linux)\n");
+    if (optind < argc)
+        printf("Workload: %d processes from %s\n", wl.n, argv[optind]);
+    else
+        printf("Workload: %d generated processes, seed %llu\n", wl.n, (unsigned long long)seed);
+    if (base.mem_mb > 0) {
+        if (wl.mem_mb) {
+            printf("Memory: %.0f MB, job footprints from the mem column, %d runs in parallel\n",
+                   base.mem_mb, nrun);
+        } else {
+            printf("Memory: %.0f MB, every job %.0f MB, %d runs in parallel\n",
+                   base.mem_mb, SCHED_JOB_MEM_MB, nrun);
+        }
+    } else {
+        printf("Swap Time: %.6f units, %d runs in parallel\n", swap, nrun);
+    }
+    printf("Context Switch Cost: %.9f units per preemption\n", base.switch_cost);
+
+    struct timespec s, e;
+    clock_gettime(CLOCK_MONOTONIC, &s);
+    for (int i = 0; i < nrun; i++) {
+        runs[i].wl = &wl;
+        runs[i].cfg.swap_time = swap;
+        if (pthread_create(&runs[i].tid, NULL, cmp_worker, &runs[i]) != 0) {
+            runs[i].tid = pthread_self();
+            cmp_worker(&runs[i]);
+        }
+    }
+    for (int i = 0; i < nrun; i++)
+        if (!pthread_equal(runs[i].tid, pthread_self())) pthread_join(runs[i].tid, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &e);
+
+    int failed = 0;
+    for (int i = 0; i < nrun; i++) {
+        if (runs[i].rc != 0) {
+            fprintf(stderr, "%s: out of memory for %d processes\n", runs[i].label, wl.n);
+            failed = 1;
+        }
+    }
+    if (!failed) {
+        print_comparison(runs, nrun);
+        printf("Wall Time                  : %.6f seconds\n", elapsed_sec(&s, &e));
+    }
+
+    for (int i = 0; i < nrun; i++) sched_free(&runs[i].ctx);
+    workload_free(&wl);
+    return failed;
+}
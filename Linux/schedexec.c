@@ -0,0 +1,389 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sched_engine.h"
+
+// ================= REAL EXECUTION =================
+
+/*
+ * Runs a policy for real. The workload is simulated on one CPU first
+ * and every slice it dispatches is recorded; then one worker process
+ * per job is forked onto the chosen core, where it burns CPU until it
+ * has used its burst (1 unit = -u milliseconds of CPU time). The driver
+ * replays the recorded slices in order, each no earlier than its
+ * simulated start: SIGCONT the worker, let it run for the slice, SIGSTOP
+ * it. A job's last slice lasts until the worker has actually used its
+ * whole burst, so time lost to real overhead shows up as drift.
+ *
+ * Workers publish a heartbeat and the dispatch generation they last saw
+ * in a shared page, which gives the measured start of every slice (first
+ * heartbeat after SIGCONT), how long a worker kept running after SIGSTOP,
+ * and the gap between one worker stopping and the next one running. When
+ * the kernel permits it, workers run SCHED_FIFO and the driver one level
+ * above them, so nothing else time-shares the core.
+ */
+#define EXEC_MAX_JOBS 1024
+#define EXEC_DEFAULT_UNIT_MS 20.0
+
+struct exec_slice {
+    int idx;
+    double start, len;  // simulated
+};
+
+/* Written by worker idx, read by the driver; one cache line each. */
+struct exec_shared {
+    _Alignas(64) int64_t seen_ns;   // last heartbeat
+    int64_t resumed_ns;             // first heartbeat of the current dispatch
+    int64_t done_ns;                // burst used up
+    uint32_t gen, seen_gen;         // dispatches issued / noticed
+};
+
+struct exec_job {
+    pid_t pid;
+    int slices_left;
+    double st, ft;      // measured, in units from the replay start
+};
+
+static struct exec_slice *plan;
+static int nplan, plan_cap;
+static int plan_failed;
+
+static int64_t mono_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (int64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+
+static void sleep_until_ns(int64_t ns) {
+    struct timespec t = { .tv_sec = ns / 1000000000, .tv_nsec = ns % 1000000000 };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL) == EINTR) {}
+}
+
+/* on_slice hook: record the plan; a dispatch inside the last slice means it was preempted. */
+static void record_slice(struct sched_ctx *c, int idx, double len) {
+    double start = c->cpu[0].start;
+
+    if (nplan > 0 && plan[nplan - 1].start + plan[nplan - 1].len > start)
+        plan[nplan - 1].len = start - plan[nplan - 1].start;
+    if (nplan == plan_cap) {
+        int cap = plan_cap ? 2 * plan_cap : 256;
+        struct exec_slice *p = realloc(plan, (size_t)cap * sizeof(*p));
+        if (!p) {
+            plan_failed = 1;
+            return;
+        }
+        plan = p;
+        plan_cap = cap;
+    }
+    plan[nplan++] = (struct exec_slice){ idx, start, len };
+}
+
+// ================= WORKERS =================
+
+static void worker(struct exec_shared *sh, double burst_sec, int core) {
+    cpu_set_t set;
+    struct timespec t;
+
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+    raise(SIGSTOP);
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+    double base = t.tv_sec + t.tv_nsec / 1e9;
+    for (;;) {
+        int64_t now = mono_ns();
+        uint32_t gen = __atomic_load_n(&sh->gen, __ATOMIC_ACQUIRE);
+        if (gen != sh->seen_gen) {
+            __atomic_store_n(&sh->resumed_ns, now, __ATOMIC_RELAXED);
+            __atomic_store_n(&sh->seen_gen, gen, __ATOMIC_RELEASE);
+        }
+        __atomic_store_n(&sh->seen_ns, now, __ATOMIC_RELAXED);
+
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+        if (t.tv_sec + t.tv_nsec / 1e9 - base >= burst_sec) {
+            __atomic_store_n(&sh->done_ns, mono_ns(), __ATOMIC_RELEASE);
+            _exit(0);
+        }
+    }
+}
+
+/* Fork every worker, stopped, pinned and (when permitted) in SCHED_FIFO below the driver. */
+static int spawn_workers(const struct workload *wl, struct exec_job *job, struct exec_shared *sh,
+                         double unit, int core, int fifo) {
+    for (int i = 0; i < wl->n; i++) {
+        int st;
+        pid_t pid = fork();
+        if (pid < 0) return -1;
+        if (pid == 0) worker(&sh[i], wl->bt[i] * unit, core);
+        job[i].pid = pid;
+        if (waitpid(pid, &st, WUNTRACED) != pid || !WIFSTOPPED(st)) return -1;
+        if (fifo) {
+            struct sched_param sp = { .sched_priority = 1 };
+            sched_setscheduler(pid, SCHED_FIFO, &sp);
+        }
+    }
+    return 0;
+}
+
+static void kill_workers(const struct workload *wl, struct exec_job *job) {
+    for (int i = 0; i < wl->n; i++) {
+        if (job[i].pid > 0) {
+            kill(job[i].pid, SIGKILL);
+            waitpid(job[i].pid, NULL, 0);
+            job[i].pid = 0;
+        }
+    }
+}
+
+// ================= REPLAY =================
+
+struct exec_stats {
+    long slices, stops;
+    double dispatch_sum, dispatch_max;  // SIGCONT to first heartbeat, seconds
+    double stop_sum, stop_max;          // SIGSTOP to last heartbeat
+    double gap_sum, gap_max;            // one worker's last heartbeat to the next one's first
+    long gaps;
+    double makespan;                    // units
+};
+
+static void add_sample(double v, double *sum, double *max) {
+    if (v < 0) v = 0;
+    *sum += v;
+    if (v > *max) *max = v;
+}
+
+static int replay(struct exec_job *job, struct exec_shared *sh,
+                  double unit, struct exec_stats *es) {
+    int64_t t0 = mono_ns();
+    int64_t unit_ns = (int64_t)(unit * 1e9);
+    int64_t prev_seen = -1;
+    double prev_end = -1;
+
+    for (int s = 0; s < nplan; s++) {
+        const struct exec_slice *sl = &plan[s];
+        struct exec_shared *w = &sh[sl->idx];
+        int last = --job[sl->idx].slices_left == 0;
+
+        int64_t target = t0 + (int64_t)(sl->start * unit_ns);
+        if (mono_ns() < target) sleep_until_ns(target);
+
+        int64_t cont = mono_ns();
+        __atomic_store_n(&w->gen, w->gen + 1, __ATOMIC_RELEASE);
+        if (kill(job[sl->idx].pid, SIGCONT) != 0) return -1;
+
+        int st;
+        if (last) {
+            if (waitpid(job[sl->idx].pid, &st, 0) != job[sl->idx].pid) return -1;
+            job[sl->idx].pid = 0;
+        } else {
+            sleep_until_ns(cont + (int64_t)(sl->len * unit_ns));
+            int64_t stop = mono_ns();
+            if (kill(job[sl->idx].pid, SIGSTOP) != 0) return -1;
+            if (waitpid(job[sl->idx].pid, &st, WUNTRACED) != job[sl->idx].pid) return -1;
+            add_sample((__atomic_load_n(&w->seen_ns, __ATOMIC_RELAXED) - stop) / 1e9,
+                       &es->stop_sum, &es->stop_max);
+            es->stops++;
+        }
+
+        // A worker stopped straight after SIGCONT may not have run at all
+        if (__atomic_load_n(&w->seen_gen, __ATOMIC_ACQUIRE) != w->gen) continue;
+        int64_t resumed = __atomic_load_n(&w->resumed_ns, __ATOMIC_RELAXED);
+        add_sample((resumed - cont) / 1e9, &es->dispatch_sum, &es->dispatch_max);
+        es->slices++;
+
+        // Back-to-back slices in the plan: the gap between them is pure switch overhead
+        if (prev_seen >= 0 && sl->start <= prev_end + 1e-9) {
+            add_sample((resumed - prev_seen) / 1e9, &es->gap_sum, &es->gap_max);
+            es->gaps++;
+        }
+
+        double rel = (double)(resumed - t0) / unit_ns;
+        if (job[sl->idx].st < 0) job[sl->idx].st = rel;
+        if (last) {
+            job[sl->idx].ft = (double)(__atomic_load_n(&w->done_ns, __ATOMIC_ACQUIRE) - t0) / unit_ns;
+            if (job[sl->idx].ft > es->makespan) es->makespan = job[sl->idx].ft;
+            prev_seen = __atomic_load_n(&w->done_ns, __ATOMIC_ACQUIRE);
+        } else {
+            prev_seen = __atomic_load_n(&w->seen_ns, __ATOMIC_RELAXED);
+        }
+        prev_end = sl->start + sl->len;
+    }
+    return 0;
+}
+
+// ================= REPORT =================
+
+static void print_results(const struct sched_ctx *c, const struct exec_job *job,
+                          const struct exec_stats *es, double unit) {
+    const struct workload *wl = c->wl;
+    const char *rule =
+        "+--------+-------+-------+-------------------+-------------------+-------------------+\n";
+    double wt[2] = { 0 }, tat[2] = { 0 }, rt[2] = { 0 };
+
+    if (wl->n <= SCHED_TABLE_LIMIT) {
+        printf("%s", rule);
+        printf("|  PID   |  AT   |  BT   |  Start sim/real   |  Finish sim/real  |   TAT sim/real    |\n");
+        printf("%s", rule);
+    }
+    for (int i = 0; i < wl->n; i++) {
+        double rtat = job[i].ft - wl->at[i];
+        wt[0] += c->p.wt[i];
+        wt[1] += rtat - wl->bt[i];
+        tat[0] += c->p.tat[i];
+        tat[1] += rtat;
+        rt[0] += c->p.rt[i];
+        rt[1] += job[i].st - wl->at[i];
+        if (wl->n <= SCHED_TABLE_LIMIT)
+            printf("| %-6d | %-5.1f | %-5.1f | %7.2f / %-7.3f | %7.2f / %-7.3f | %7.2f / %-7.3f |\n",
+                   wl->pid[i], wl->at[i], wl->bt[i], c->p.st[i], job[i].st, c->p.ft[i], job[i].ft,
+                   c->p.tat[i], rtat);
+    }
+    if (wl->n <= SCHED_TABLE_LIMIT) printf("%s", rule);
+
+    printf("\n--- Simulated vs Measured (units) ---\n");
+    printf("Average Waiting Time       : %.4f / %.4f\n", wt[0] / wl->n, wt[1] / wl->n);
+    printf("Average Turnaround Time    : %.4f / %.4f\n", tat[0] / wl->n, tat[1] / wl->n);
+    printf("Average Response Time      : %.4f / %.4f\n", rt[0] / wl->n, rt[1] / wl->n);
+    printf("Makespan                   : %.4f / %.4f (%+.2f%%)\n", c->stats.max_ft, es->makespan,
+           (es->makespan / c->stats.max_ft - 1) * 100);
+
+    printf("\n--- Measured Dispatch Overhead ---\n");
+    printf("Slices Run                 : %ld\n", es->slices);
+    if (es->slices)
+        printf("SIGCONT to Running         : %.1f us average, %.1f us max\n",
+               es->dispatch_sum / es->slices * 1e6, es->dispatch_max * 1e6);
+    if (es->stops)
+        printf("SIGSTOP to Stopped         : %.1f us average, %.1f us max\n",
+               es->stop_sum / es->stops * 1e6, es->stop_max * 1e6);
+    if (es->gaps)
+        printf("Switch Gap                 : %.1f us average, %.1f us max (%ld back-to-back switches)\n",
+               es->gap_sum / es->gaps * 1e6, es->gap_max * 1e6, es->gaps);
+    printf("Overhead per Switch        : %.6f units\n", es->gaps ? es->gap_sum / es->gaps / unit : 0.0);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-p policy] [-q quantum] [-u ms_per_unit] [-c core] [-w swap_time]\n"
+            "          (<workload.wl> | -n jobs [-s seed])\n", prog);
+}
+
+int main(int argc, char **argv) {
+    const struct sched_policy *policy = &sched_rr;
+    struct sched_config cfg = { .ncpu = 1 };
+    double unit_ms = EXEC_DEFAULT_UNIT_MS;
+    int jobs = 0, core = -1, opt;
+    uint64_t seed = 1;
+    struct workload wl;
+    struct sched_ctx ctx;
+
+    while ((opt = getopt(argc, argv, "p:q:u:c:w:n:s:")) != -1) {
+        switch (opt) {
+        case 'p':
+            if (!(policy = sched_policy_by_name(optarg))) {
+                fprintf(stderr, "Unknown policy %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'q': cfg.quantum = atof(optarg); break;
+        case 'u': unit_ms = atof(optarg); break;
+        case 'c': core = atoi(optarg); break;
+        case 'w': cfg.swap_time = atof(optarg); break;
+        case 'n': jobs = atoi(optarg); break;
+        case 's': seed = strtoull(optarg, NULL, 0); break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if ((optind < argc) == (jobs > 0) || unit_ms <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (optind < argc) {
+        if (workload_map(&wl, argv[optind]) != 0) {
+            fprintf(stderr, "Cannot load workload file %s\n", argv[optind]);
+            return 1;
+        }
+    } else if (workload_alloc(&wl, jobs) != 0 || !(wl.nice = calloc(jobs, sizeof(int)))) {
+        fprintf(stderr, "Out of memory for %d processes\n", jobs);
+        return 1;
+    } else {
+        workload_generate(&wl, seed, 0);
+    }
+    if (wl.n > EXEC_MAX_JOBS) {
+        fprintf(stderr, "At most %d processes can run for real\n", EXEC_MAX_JOBS);
+        return 1;
+    }
+
+    if (sched_init(&ctx, &wl, policy, &cfg) != 0) {
+        fprintf(stderr, "Out of memory for %d processes\n", wl.n);
+        return 1;
+    }
+    ctx.on_slice = record_slice;
+    if (sched_run(&ctx) != 0 || plan_failed) {
+        fprintf(stderr, "Out of memory for %d processes\n", wl.n);
+        return 1;
+    }
+
+    // Workers share one core, by default the last; the driver keeps to the others if there are any
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    if (core < 0 || core >= ncpu) core = (int)ncpu - 1;
+    if (ncpu > 1) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int k = 0; k < ncpu; k++)
+            if (k != core) CPU_SET(k, &set);
+        sched_setaffinity(0, sizeof(set), &set);
+    }
+    struct sched_param sp = { .sched_priority = 2 };
+    int fifo = sched_setscheduler(0, SCHED_FIFO, &sp) == 0;
+
+    struct exec_job *job = calloc(wl.n, sizeof(*job));
+    struct exec_shared *sh = mmap(NULL, (size_t)wl.n * sizeof(*sh), PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (!job || sh == MAP_FAILED) {
+        fprintf(stderr, "Out of memory for %d processes\n", wl.n);
+        return 1;
+    }
+    for (int i = 0; i < wl.n; i++) job[i].st = -1;
+    for (int s = 0; s < nplan; s++) job[plan[s].idx].slices_left++;
+
+    double unit = unit_ms / 1000;
+    printf("CampusConnect Real Execution (Linux)\n");
+    if (policy == &sched_rr || policy == &sched_mlfq)
+        printf("Policy: %s (q=%g), %d processes, %d slices\n", policy->name, ctx.cfg.quantum, wl.n, nplan);
+    else
+        printf("Policy: %s, %d processes, %d slices\n", policy->name, wl.n, nplan);
+    printf("Workers: CPU %d, %s, 1 unit = %g ms\n", core,
+           fifo ? "SCHED_FIFO" : "SCHED_OTHER (SCHED_FIFO not permitted)", unit_ms);
+    fflush(stdout);
+
+    struct exec_stats es = { 0 };
+    int rc = spawn_workers(&wl, job, sh, unit, core, fifo);
+    if (rc == 0) rc = replay(job, sh, unit, &es);
+    kill_workers(&wl, job);
+    if (rc != 0)
+        perror("Real execution failed");
+    else
+        print_results(&ctx, job, &es, unit);
+
+    munmap(sh, (size_t)wl.n * sizeof(*sh));
+    free(job);
+    free(plan);
+    sched_free(&ctx);
+    workload_free(&wl);
+    return rc != 0;
+}
@@ -0,0 +1,174 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sched_trace.h"
+
+#define LOG_CHUNK 4096
+
+// ================= EVENT LOG DECODER =================
+
+/*
+ * Turns a binary event log from one of the lin* simulators back into
+ * the text view, or into Chrome trace-event JSON for chrome://tracing
+ * and ui.perfetto.dev. Records are streamed a chunk at a time and each
+ * one is written out as soon as it is read, so the size of the log (or
+ * of the JSON) never matters; stdout gets a large buffer since
+ * formatting is now the only cost left.
+ */
+static void print_text(const struct trace_rec *r, int ncpu, int slices_only) {
+    char cpu[16] = "";
+    if (ncpu > 1) snprintf(cpu, sizeof(cpu), "CPU %d: ", r->cpu);
+
+    switch (r->type) {
+    case TR_DISPATCH:
+        printf("Time %.2f: %sPID %d runs for %.2f units\n", r->time, cpu, r->pid, r->len);
+        break;
+    case TR_PREEMPT:
+        if (!slices_only)
+            printf("Time %.2f: %sPID %d preempted, %.2f units left\n", r->time, cpu, r->pid, r->len);
+        break;
+    case TR_COMPLETE:
+        if (!slices_only)
+            printf("Time %.2f: %sPID %d completes, turnaround %.2f\n", r->time, cpu, r->pid, r->len);
+        break;
+    case TR_SWAP:
+        if (!slices_only)
+            printf("Time %.2f: %sPID %d swapped in, %.6f units\n", r->time, cpu, r->pid, r->len);
+        break;
+    case TR_ARRIVAL:
+        if (!slices_only)
+            printf("Time %.2f: %sPID %d arrives, burst %.2f\n", r->time, cpu, r->pid, r->len);
+        break;
+    }
+}
+
+// ================= CHROME TRACE-EVENT JSON =================
+
+/*
+ * One simulated time unit is shown as one millisecond (trace timestamps
+ * are in microseconds). Trace process 0 holds one track per CPU with
+ * the slices it ran and the swap-ins charged before them, plus a
+ * ready-queue counter per CPU sampled at every logged event. Trace
+ * process 1 holds one track per simulated PID: the slices it got, and
+ * instants for its arrival, preemptions and completion.
+ */
+#define CHROME_US_PER_UNIT 1000.0
+#define CHROME_CPUS 0
+#define CHROME_PROCS 1
+
+static void chrome_begin(int ncpu) {
+    printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    printf("{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%d,\"args\":{\"name\":\"CPUs\"}},\n", CHROME_CPUS);
+    printf("{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%d,\"args\":{\"name\":\"Processes\"}}", CHROME_PROCS);
+    for (int k = 0; k < ncpu; k++)
+        printf(",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"CPU %d\"}}",
+               CHROME_CPUS, k, k);
+}
+
+static void chrome_slice(int pid, int tid, const char *name, int id, const char *cat,
+                         double ts, double dur) {
+    printf(",\n{\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"name\":\"%s %d\",\"cat\":\"%s\",\"ts\":%.3f,\"dur\":%.3f}",
+           pid, tid, name, id, cat, ts * CHROME_US_PER_UNIT, dur * CHROME_US_PER_UNIT);
+}
+
+static void chrome_instant(int pid, const char *name, double ts, const char *arg, double v) {
+    printf(",\n{\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%d,\"name\":\"%s\",\"ts\":%.3f,\"args\":{\"%s\":%.6g}}",
+           CHROME_PROCS, pid, name, ts * CHROME_US_PER_UNIT, arg, v);
+}
+
+static void print_chrome(const struct trace_rec *r) {
+    switch (r->type) {
+    case TR_DISPATCH:
+        chrome_slice(CHROME_CPUS, r->cpu, "PID", r->pid, "run", r->time, r->len);
+        chrome_slice(CHROME_PROCS, r->pid, "CPU", r->cpu, "run", r->time, r->len);
+        break;
+    case TR_SWAP:
+        chrome_slice(CHROME_CPUS, r->cpu, "Swap-in PID", r->pid, "swap", r->time, r->len);
+        break;
+    case TR_PREEMPT:
+        chrome_instant(r->pid, "Preempted", r->time, "remaining", r->len);
+        break;
+    case TR_COMPLETE:
+        chrome_instant(r->pid, "Completed", r->time, "turnaround", r->len);
+        printf(",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"PID %d\"}}",
+               CHROME_PROCS, r->pid, r->pid);
+        break;
+    case TR_ARRIVAL:
+        chrome_instant(r->pid, "Arrived", r->time, "burst", r->len);
+        break;
+    default:
+        return;
+    }
+    printf(",\n{\"ph\":\"C\",\"pid\":%d,\"name\":\"Ready Queue %d\",\"ts\":%.3f,\"args\":{\"jobs\":%d}}",
+           CHROME_CPUS, r->cpu, r->time * CHROME_US_PER_UNIT, r->queued);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [-s | -c] <events.log>\n"
+                    "  -s  dispatched slices only\n"
+                    "  -c  Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev)\n", prog);
+}
+
+int main(int argc, char **argv) {
+    int slices_only = 0, chrome = 0, opt;
+
+    while ((opt = getopt(argc, argv, "sc")) != -1) {
+        switch (opt) {
+        case 's': slices_only = 1; break;
+        case 'c': chrome = 1; break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE *in = fopen(argv[optind], "rb");
+    if (!in) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    struct trace_header h;
+    if (fread(&h, sizeof(h), 1, in) != 1 || memcmp(h.magic, TRACE_MAGIC, sizeof(h.magic)) != 0 ||
+        h.version != TRACE_VERSION || h.rec_size != sizeof(struct trace_rec) ||
+        h.endian != TRACE_ENDIAN) {
+        fprintf(stderr, "%s: not a version %d event log for this machine\n", argv[optind], TRACE_VERSION);
+        fclose(in);
+        return 1;
+    }
+
+    static struct trace_rec buf[LOG_CHUNK];
+    static char out[1 << 20];
+    setvbuf(stdout, out, _IOFBF, sizeof(out));
+
+    if (chrome) chrome_begin((int)h.ncpu);
+    size_t got;
+    long long total = 0;
+    while ((got = fread(buf, sizeof(buf[0]), LOG_CHUNK, in)) > 0) {
+        for (size_t i = 0; i < got; i++) {
+            if (chrome)
+                print_chrome(&buf[i]);
+            else
+                print_text(&buf[i], (int)h.ncpu, slices_only);
+        }
+        total += got;
+    }
+    if (chrome) printf("\n]}\n");
+    int bad = ferror(in);
+    fclose(in);
+
+    if (fflush(stdout) != 0) {
+        perror("stdout");
+        return 1;
+    }
+    if (bad) {
+        fprintf(stderr, "%s: read error after %lld records\n", argv[optind], total);
+        return 1;
+    }
+    return 0;
+}
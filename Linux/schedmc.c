@@ -0,0 +1,245 @@
+#define _POSIX_C_SOURCE 200809L
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "sched_engine.h"
+
+// ================= MONTE CARLO BATCH =================
+
+/*
+ * Run r simulates random stream r of the seed under every selected
+ * policy. Workers claim runs from a shared counter and write to their
+ * own result slots, so results do not depend on the thread count or on
+ * which thread ran what, and the only shared write is the counter.
+ * Each worker also folds every run's per-job histograms into its own
+ * set, and the sets are merged once all workers finish.
+ */
+#define MC_METRICS SCHED_METRICS
+#define MC_MAX_POLICIES 16
+
+static const char *metric_names[MC_METRICS] = { "WT", "TAT", "RT" };
+
+struct mc_batch {
+    int runs, jobs;
+    uint64_t seed;
+    int npol;
+    const struct sched_policy *pol[MC_MAX_POLICIES];
+    struct sched_config cfg;
+    double *avg;        // [run][policy][metric]
+    int next_run;
+    int failed;
+};
+
+struct mc_worker {
+    struct mc_batch *b;
+    struct sched_hist *hist;    // [policy][metric], per-job values of every run
+    pthread_t tid;
+};
+
+static void *mc_worker(void *arg) {
+    struct mc_worker *w = arg;
+    struct mc_batch *b = w->b;
+    struct workload wl;
+    struct sched_ctx ctx;
+
+    if (workload_alloc(&wl, b->jobs) != 0 || !(wl.nice = calloc(b->jobs, sizeof(int))) ||
+        (b->cfg.mem_mb > 0 && !(wl.mem_mb = calloc(b->jobs, sizeof(double))))) {
+        workload_free(&wl);
+        __atomic_store_n(&b->failed, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    for (;;) {
+        int r = __atomic_fetch_add(&b->next_run, 1, __ATOMIC_RELAXED);
+        if (r >= b->runs) break;
+
+        workload_generate(&wl, b->seed, r);
+        for (int k = 0; k < b->npol; k++) {
+            double *out = &b->avg[((size_t)r * b->npol + k) * MC_METRICS];
+            if (sched_init(&ctx, &wl, b->pol[k], &b->cfg) != 0 || sched_run(&ctx) != 0) {
+                sched_free(&ctx);
+                __atomic_store_n(&b->failed, 1, __ATOMIC_RELAXED);
+                goto out;
+            }
+            out[0] = ctx.stats.total_wt / wl.n;
+            out[1] = ctx.stats.total_tat / wl.n;
+            out[2] = ctx.stats.total_rt / wl.n;
+            for (int m = 0; m < MC_METRICS; m++)
+                hist_merge(&w->hist[k * MC_METRICS + m], &ctx.hist[m]);
+            sched_free(&ctx);
+        }
+    }
+
+out:
+    workload_free(&wl);
+    return NULL;
+}
+
+/*
+ * Two-sided 95% Student t quantile: tabulated for 1..30 degrees of
+ * freedom, then the Cornish-Fisher expansion around z = 1.96, which is
+ * within 1e-4 of the exact value from df 30 on and meets the table there.
+ */
+static double t95(int df) {
+    static const double t[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+    };
+    if (df < 1) return 1.960;
+    if (df <= 30) return t[df - 1];
+
+    const double z = 1.959964, z2 = z * z;
+    double v = df;
+    return z + z * (z2 + 1) / (4 * v) + z * ((5 * z2 + 16) * z2 + 3) / (96 * v * v) +
+           z * (((3 * z2 + 19) * z2 + 17) * z2 - 15) / (384 * v * v * v);
+}
+
+static void print_summary(const struct mc_batch *b) {
+    const char *rule =
+        "+----------+--------+------------+------------+---------------------------+------------+------------+\n";
+
+    printf("\n%s", rule);
+    printf("| Policy   | Metric |    Mean    |  Std Dev   |          95%% CI           |    Min     |    Max     |\n");
+    printf("%s", rule);
+    for (int k = 0; k < b->npol; k++) {
+        for (int m = 0; m < MC_METRICS; m++) {
+            double sum = 0, sq = 0, lo = INFINITY, hi = -INFINITY;
+            for (int r = 0; r < b->runs; r++) {
+                double v = b->avg[((size_t)r * b->npol + k) * MC_METRICS + m];
+                sum += v;
+                if (v < lo) lo = v;
+                if (v > hi) hi = v;
+            }
+            double mean = sum / b->runs;
+            for (int r = 0; r < b->runs; r++) {
+                double d = b->avg[((size_t)r * b->npol + k) * MC_METRICS + m] - mean;
+                sq += d * d;
+            }
+            double sd = (b->runs > 1) ? sqrt(sq / (b->runs - 1)) : 0;
+            double half = t95(b->runs - 1) * sd / sqrt(b->runs);
+
+            char ci[64];
+            snprintf(ci, sizeof(ci), "[%.3f, %.3f]", mean - half, mean + half);
+            printf("| %-8s | %-6s | %-10.3f | %-10.3f | %-25s | %-10.3f | %-10.3f |\n",
+                   m == 0 ? b->pol[k]->name : "", metric_names[m], mean, sd, ci, lo, hi);
+        }
+        printf("%s", rule);
+    }
+}
+
+static void print_tails(const struct mc_batch *b, const struct sched_hist *hist) {
+    for (int k = 0; k < b->npol; k++) {
+        printf("\n%s, all jobs of all runs:", b->pol[k]->name);
+        sched_print_percentiles(&hist[k * MC_METRICS]);
+    }
+}
+
+static int parse_policies(struct mc_batch *b, char *list) {
+    for (char *tok = strtok(list, ","); tok; tok = strtok(NULL, ",")) {
+        const struct sched_policy *p = sched_policy_by_name(tok);
+        if (!p || b->npol == MC_MAX_POLICIES) {
+            fprintf(stderr, "Unknown policy %s\n", tok);
+            return -1;
+        }
+        b->pol[b->npol++] = p;
+    }
+    return 0;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-r runs] [-n jobs] [-s seed] [-t threads] [-q quantum]\n"
+            "          [-w swap_time | -m memory_mb] [-p policy[,policy...]]\n", prog);
+}
+
+int main(int argc, char **argv) {
+    struct mc_batch b = { .runs = 1000, .jobs = 20, .seed = 1 };
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+
+    while ((opt = getopt(argc, argv, "r:n:s:t:q:w:m:p:")) != -1) {
+        switch (opt) {
+        case 'r': b.runs = atoi(optarg); break;
+        case 'n': b.jobs = atoi(optarg); break;
+        case 's': b.seed = strtoull(optarg, NULL, 0); break;
+        case 't': threads = atol(optarg); break;
+        case 'q': b.cfg.quantum = atof(optarg); break;
+        case 'w': b.cfg.swap_time = atof(optarg); break;
+        case 'm': b.cfg.mem_mb = atof(optarg); break;
+        case 'p':
+            if (parse_policies(&b, optarg) != 0) return 1;
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (b.runs < 1 || b.jobs < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (threads < 1) threads = 1;
+    if (threads > b.runs) threads = b.runs;
+    if (b.npol == 0)
+        for (int i = 0; sched_policies[i] && b.npol < MC_MAX_POLICIES; i++)
+            b.pol[b.npol++] = sched_policies[i];
+
+    size_t nhist = (size_t)b.npol * MC_METRICS;
+    b.avg = malloc((size_t)b.runs * nhist * sizeof(double));
+    struct mc_worker *w = calloc(threads, sizeof(*w));
+    int ok = b.avg && w;
+    for (long i = 0; ok && i < threads; i++) {
+        w[i].b = &b;
+        ok = (w[i].hist = malloc(nhist * sizeof(struct sched_hist))) != NULL;
+        for (size_t h = 0; ok && h < nhist; h++) hist_reset(&w[i].hist[h]);
+    }
+    if (!ok) {
+        fprintf(stderr, "Out of memory for %d runs\n", b.runs);
+        return 1;
+    }
+
+    printf("CampusConnect Monte Carlo Comparison (Linux)\n");
+    if (b.cfg.mem_mb > 0) {
+        // Calibrate once here rather than in every run
+        struct swap_calib cal;
+        if (calib_get(&cal) == 0) calib_swap_model(&cal, &b.cfg.swap_dev);
+        printf("Runs: %d x %d jobs (16-256 MB each), seed %llu, %ld threads, %.0f MB memory\n",
+               b.runs, b.jobs, (unsigned long long)b.seed, threads, b.cfg.mem_mb);
+    } else {
+        printf("Runs: %d x %d jobs, seed %llu, %ld threads, swap time %.4f\n",
+               b.runs, b.jobs, (unsigned long long)b.seed, threads, b.cfg.swap_time);
+    }
+
+    struct timespec s, e;
+    clock_gettime(CLOCK_MONOTONIC, &s);
+    long started = 0;
+    for (; started < threads; started++)
+        if (pthread_create(&w[started].tid, NULL, mc_worker, &w[started]) != 0) break;
+    if (started == 0) mc_worker(&w[0]);
+    for (long i = 0; i < started; i++) pthread_join(w[i].tid, NULL);
+    for (long i = 1; i < threads; i++)
+        for (size_t h = 0; h < nhist; h++) hist_merge(&w[0].hist[h], &w[i].hist[h]);
+    clock_gettime(CLOCK_MONOTONIC, &e);
+
+    if (b.failed) {
+        fprintf(stderr, "Simulation failed (out of memory)\n");
+        return 1;
+    }
+
+    print_summary(&b);
+    print_tails(&b, w[0].hist);
+    double wall = elapsed_sec(&s, &e);
+    printf("Wall Time                  : %.6f seconds\n", wall);
+    printf("Simulations/sec            : %.0f\n", (double)b.runs * b.npol / wall);
+
+    for (long i = 0; i < threads; i++) free(w[i].hist);
+    free(w);
+    free(b.avg);
+    return 0;
+}
@@ -0,0 +1,73 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sched_calib.h"
+#include "sched_switch.h"
+
+// ================= CONTEXT SWITCH BENCHMARK =================
+
+/*
+ * Runs the ping-pong benchmark behind the simulators' per-switch cost,
+ * refreshes the cache entry for this host and prints every mechanism,
+ * peer kind and placement. With -c it only shows the cached numbers.
+ */
+static void print_costs(const struct switch_calib *c) {
+    const char *rule = "+---------+-----------+-------------+-------------+\n";
+    static const char *peers[SWITCH_NPEER] = { "threads", "processes" };
+
+    printf("%s", rule);
+    printf("|  Mech   |   Peers   |  Same Core  | Cross Core  |\n");
+    printf("%s", rule);
+    for (int m = 0; m < SWITCH_NMECH; m++) {
+        for (int p = 0; p < SWITCH_NPEER; p++) {
+            char cell[SWITCH_NPLACE][16];
+            for (int k = 0; k < SWITCH_NPLACE; k++) {
+                if (c->cost[m][p][k] > 0)
+                    snprintf(cell[k], sizeof(cell[k]), "%.2f us", c->cost[m][p][k] * 1e6);
+                else
+                    snprintf(cell[k], sizeof(cell[k]), "n/a");
+            }
+            printf("| %-7s | %-9s | %-11s | %-11s |\n", p == 0 ? switch_mech_names[m] : "", peers[p],
+                   cell[SWITCH_SAME_CORE], cell[SWITCH_CROSS_CORE]);
+        }
+    }
+    printf("%s", rule);
+    printf("Per handoff: half a round trip, so one block plus one wakeup.\n");
+    printf("Charged per Preemption     : %.9f units (processes, same core, cheapest mechanism)\n",
+           switch_cost(c));
+}
+
+int main(int argc, char **argv) {
+    int cached = 0, opt;
+    struct switch_calib c;
+
+    while ((opt = getopt(argc, argv, "c")) != -1) {
+        if (opt != 'c') {
+            fprintf(stderr, "Usage: %s [-c]\n", argv[0]);
+            return 1;
+        }
+        cached = 1;
+    }
+
+    printf("CampusConnect Context Switch Benchmark (Linux)\n");
+    if (cached) {
+        if (switch_load(&c) != 0) {
+            fprintf(stderr, "No fresh switch cost cached for this host\n");
+            return 1;
+        }
+    } else {
+        struct timespec s, e;
+        clock_gettime(CLOCK_MONOTONIC, &s);
+        if (switch_measure(&c) != 0) {
+            perror("Benchmark failed");
+            return 1;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &e);
+        printf("Benchmark Time: %.3f seconds\n", elapsed_sec(&s, &e));
+        if (switch_store(&c) != 0) fprintf(stderr, "Could not update the calibration cache\n");
+    }
+    print_costs(&c);
+    return 0;
+}
@@ -0,0 +1,163 @@
+#define _POSIX_C_SOURCE 200809L
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sched_engine.h"
+#include "sched_incr.h"
+
+// ================= WHAT-IF EDITS =================
+
+/*
+ * Runs one policy over a workload, then reads edits from stdin, one
+ * "pid at bt" per line ('-' keeps a field), and re-simulates only the
+ * part of the schedule each edit reaches. With -c every edit is also
+ * checked against a full run of the edited workload.
+ */
+static const char *rule =
+    "+------------+------------+------------+--------------+------------+------------+------------+--------------+---------+\n";
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-p fcfs|sjf|priority] [-w swap_time] [-c] (<workload.wl> | -n jobs [-s seed])\n"
+            "       edits on stdin: pid at bt ('-' keeps a field)\n", prog);
+}
+
+static int find_pid(const struct workload *wl, int pid) {
+    for (int i = 0; i < wl->n; i++)
+        if (wl->pid[i] == pid) return i;
+    return -1;
+}
+
+/* Same results as a fresh run of the edited workload, bit for bit. */
+static int matches_full_run(const struct sched_ctx *c) {
+    struct sched_ctx f;
+    size_t d = (size_t)c->wl->n * sizeof(double);
+
+    if (sched_init(&f, c->wl, c->policy, &c->cfg) != 0 || sched_run(&f) != 0) {
+        sched_free(&f);
+        return -1;
+    }
+    int same = memcmp(f.p.st, c->p.st, d) == 0 && memcmp(f.p.ft, c->p.ft, d) == 0 &&
+               memcmp(f.p.wt, c->p.wt, d) == 0 && memcmp(f.p.tat, c->p.tat, d) == 0 &&
+               memcmp(f.p.rt, c->p.rt, d) == 0 &&
+               memcmp(f.done_order, c->done_order, (size_t)c->wl->n * sizeof(int)) == 0 &&
+               f.stats.total_wt == c->stats.total_wt && f.stats.total_tat == c->stats.total_tat &&
+               f.stats.total_swaps == c->stats.total_swaps && f.stats.max_ft == c->stats.max_ft;
+    sched_free(&f);
+    return same;
+}
+
+static void print_row(const struct sched_ctx *c, const char *label, int resimulated, const char *check) {
+    const struct sched_stats *s = &c->stats;
+    int n = c->wl->n;
+
+    printf("| %-10s | %-10.2f | %-10.2f | %-12.2f | %-10.2f | %-10.2f | %-10.2f | %-12d | %-7s |\n",
+           label, s->exec_time * 1e3, s->total_wt / n, s->max_wt, s->total_tat / n, s->total_rt / n,
+           s->max_ft, resimulated, check);
+}
+
+int main(int argc, char **argv) {
+    const struct sched_policy *policy = &sched_sjf;
+    struct sched_config cfg = { .swap_time = -1 };
+    struct workload wl;
+    struct sched_ctx ctx;
+    int jobs = 0, check = 0, opt;
+    uint64_t seed = 1;
+
+    while ((opt = getopt(argc, argv, "p:w:cn:s:")) != -1) {
+        switch (opt) {
+        case 'p':
+            if (!(policy = sched_policy_by_name(optarg))) {
+                fprintf(stderr, "Unknown policy %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'w': cfg.swap_time = atof(optarg); break;
+        case 'c': check = 1; break;
+        case 'n': jobs = atoi(optarg); break;
+        case 's': seed = strtoull(optarg, NULL, 0); break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if ((optind < argc) == (jobs > 0)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (optind < argc) {
+        if (workload_map(&wl, argv[optind]) != 0) {
+            fprintf(stderr, "Cannot load workload file %s\n", argv[optind]);
+            return 1;
+        }
+    } else if (workload_alloc(&wl, jobs) != 0) {
+        fprintf(stderr, "Out of memory for %d processes\n", jobs);
+        return 1;
+    } else {
+        workload_generate(&wl, seed, 0);
+    }
+    if (cfg.swap_time < 0) cfg.swap_time = measure_hardware_swap();
+
+    printf("CampusConnect What-If Scheduler (Linux)\n");
+    if (optind < argc)
+        printf("Workload: %d processes from %s\n", wl.n, argv[optind]);
+    else
+        printf("Workload: %d generated processes, seed %llu\n", wl.n, (unsigned long long)seed);
+    printf("Policy: %s, Swap Time: %.6f units\n", policy->name, cfg.swap_time);
+
+    if (sched_init(&ctx, &wl, policy, &cfg) != 0 || sched_run(&ctx) != 0) {
+        fprintf(stderr, "Out of memory for %d processes\n", wl.n);
+        return 1;
+    }
+    if (!incr_applies(&ctx)) printf("(%s cannot be edited incrementally: every edit is a full run)\n", policy->name);
+
+    printf("\n%s", rule);
+    printf("|    Edit    |  Time (ms) |   Avg WT   |    Max WT    |  Avg TAT   |   Avg RT   |  Makespan  | Re-simulated | Check   |\n");
+    printf("%s", rule);
+    print_row(&ctx, "baseline", wl.n, "-");
+
+    char line[256];
+    int rc = 0;
+    while (fgets(line, sizeof(line), stdin)) {
+        char f_at[64], f_bt[64];
+        int pid;
+        if (sscanf(line, "%d %63s %63s", &pid, f_at, f_bt) != 3) continue;
+
+        int idx = find_pid(&wl, pid);
+        if (idx < 0) {
+            fprintf(stderr, "No process with PID %d\n", pid);
+            continue;
+        }
+        double at = strcmp(f_at, "-") ? atof(f_at) : wl.at[idx];
+        double bt = strcmp(f_bt, "-") ? atof(f_bt) : wl.bt[idx];
+        if (!isfinite(at) || !isfinite(bt) || at < 0 || bt < 0) {
+            fprintf(stderr, "PID %d: AT and BT must be finite and not negative\n", pid);
+            continue;
+        }
+        int k = sched_edit(&ctx, &wl, idx, at, bt);
+        if (k < 0) {
+            fprintf(stderr, "Edit of PID %d failed\n", pid);
+            rc = 1;
+            break;
+        }
+
+        char label[16];
+        const char *verdict = "-";
+        snprintf(label, sizeof(label), "PID %d", pid);
+        if (check) {
+            int same = matches_full_run(&ctx);
+            verdict = same > 0 ? "same" : "DIFFERS";
+            if (same <= 0) rc = 1;
+        }
+        print_row(&ctx, label, k, verdict);
+    }
+    printf("%s", rule);
+
+    sched_free(&ctx);
+    workload_free(&wl);
+    return rc;
+}
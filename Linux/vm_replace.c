@@ -0,0 +1,547 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "vm_replace.h"
+
+// ================= PAGE MAP =================
+
+int vm_map_init(struct vm_map *m, int capacity) {
+    int bits = 4;
+    while ((1ULL << bits) < 2ULL * (uint64_t)capacity) bits++;
+
+    m->mask = (1ULL << bits) - 1;
+    m->shift = 64 - bits;
+    m->key = malloc((m->mask + 1) * sizeof(uint64_t));
+    m->val = malloc((m->mask + 1) * sizeof(int32_t));
+    if (!m->key || !m->val) {
+        vm_map_free(m);
+        return -1;
+    }
+    memset(m->val, 0xff, (m->mask + 1) * sizeof(int32_t));
+    return 0;
+}
+
+void vm_map_free(struct vm_map *m) {
+    free(m->key);
+    free(m->val);
+    m->key = NULL;
+    m->val = NULL;
+}
+
+static inline uint64_t map_home(const struct vm_map *m, uint64_t page) {
+    return (page * 0x9e3779b97f4a7c15ULL) >> m->shift;
+}
+
+int32_t vm_map_find(const struct vm_map *m, uint64_t page) {
+    for (uint64_t i = map_home(m, page);; i = (i + 1) & m->mask) {
+        if (m->val[i] < 0) return -1;
+        if (m->key[i] == page) return m->val[i];
+    }
+}
+
+/* `page` must not be in the map yet. */
+void vm_map_put(struct vm_map *m, uint64_t page, int32_t slot) {
+    uint64_t i = map_home(m, page);
+    while (m->val[i] >= 0) i = (i + 1) & m->mask;
+    m->key[i] = page;
+    m->val[i] = slot;
+}
+
+/* Remove and pull later entries of the probe run back, so no tombstones build up. */
+void vm_map_del(struct vm_map *m, uint64_t page) {
+    uint64_t i = map_home(m, page);
+    while (m->val[i] >= 0 && m->key[i] != page) i = (i + 1) & m->mask;
+    if (m->val[i] < 0) return;
+
+    for (uint64_t j = i;;) {
+        j = (j + 1) & m->mask;
+        if (m->val[j] < 0) break;
+        uint64_t k = map_home(m, m->key[j]);
+        // Entry j may fill the hole at i unless its home lies cyclically in (i, j]
+        if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j)) continue;
+        m->key[i] = m->key[j];
+        m->val[i] = m->val[j];
+        i = j;
+    }
+    m->val[i] = -1;
+}
+
+// ================= INTRUSIVE LISTS =================
+
+/* Doubly linked lists threaded through per-policy prev/next arrays; head is most recent. */
+struct vm_list {
+    int head, tail, len;
+};
+
+static inline void list_init(struct vm_list *l) {
+    l->head = l->tail = -1;
+    l->len = 0;
+}
+
+static inline void list_push(struct vm_list *l, int32_t *prev, int32_t *next, int x) {
+    prev[x] = -1;
+    next[x] = l->head;
+    if (l->head >= 0) prev[l->head] = x; else l->tail = x;
+    l->head = x;
+    l->len++;
+}
+
+static inline void list_unlink(struct vm_list *l, int32_t *prev, int32_t *next, int x) {
+    if (prev[x] >= 0) next[prev[x]] = next[x]; else l->head = next[x];
+    if (next[x] >= 0) prev[next[x]] = prev[x]; else l->tail = prev[x];
+    l->len--;
+}
+
+// ================= FIFO AND CLOCK =================
+
+/* Frames in a ring; the hand marks the oldest page (FIFO) or the next to inspect (Clock). */
+struct vm_ring {
+    struct vm_map map;
+    uint64_t *page;
+    uint8_t *ref;
+    int used, hand;
+};
+
+static void ring_destroy(struct vm_cache *v) {
+    struct vm_ring *r = v->pdata;
+    if (!r) return;
+    vm_map_free(&r->map);
+    free(r->page);
+    free(r->ref);
+    free(r);
+    v->pdata = NULL;
+}
+
+static int ring_init(struct vm_cache *v) {
+    struct vm_ring *r = calloc(1, sizeof(*r));
+    if (!(v->pdata = r)) return -1;
+    r->page = malloc((size_t)v->frames * sizeof(uint64_t));
+    r->ref = calloc((size_t)v->frames, 1);
+    if (!r->page || !r->ref || vm_map_init(&r->map, v->frames) != 0) {
+        ring_destroy(v);
+        return -1;
+    }
+    return 0;
+}
+
+static void fifo_run(struct vm_cache *v, const uint64_t *refs, size_t n) {
+    struct vm_ring *r = v->pdata;
+    uint64_t hits = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t p = refs[i];
+        if (vm_map_find(&r->map, p) >= 0) {
+            hits++;
+            continue;
+        }
+        int slot;
+        if (r->used < v->frames) {
+            slot = r->used++;
+        } else {
+            slot = r->hand;
+            r->hand = (r->hand + 1 == v->frames) ? 0 : r->hand + 1;
+            vm_map_del(&r->map, r->page[slot]);
+        }
+        r->page[slot] = p;
+        vm_map_put(&r->map, p, slot);
+    }
+    v->hits += hits;
+    v->refs += n;
+}
+
+static void clock_run(struct vm_cache *v, const uint64_t *refs, size_t n) {
+    struct vm_ring *r = v->pdata;
+    uint64_t hits = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t p = refs[i];
+        int32_t slot = vm_map_find(&r->map, p);
+        if (slot >= 0) {
+            r->ref[slot] = 1;
+            hits++;
+            continue;
+        }
+        if (r->used < v->frames) {
+            slot = r->used++;
+        } else {
+            // Each pass clears a bit, so the hand stops within one sweep
+            while (r->ref[r->hand]) {
+                r->ref[r->hand] = 0;
+                r->hand = (r->hand + 1 == v->frames) ? 0 : r->hand + 1;
+            }
+            slot = r->hand;
+            r->hand = (r->hand + 1 == v->frames) ? 0 : r->hand + 1;
+            vm_map_del(&r->map, r->page[slot]);
+        }
+        r->page[slot] = p;
+        r->ref[slot] = 0;
+        vm_map_put(&r->map, p, slot);
+    }
+    v->hits += hits;
+    v->refs += n;
+}
+
+const struct vm_policy vm_fifo = { "FIFO", ring_init, ring_destroy, fifo_run };
+const struct vm_policy vm_clock = { "Clock", ring_init, ring_destroy, clock_run };
+
+// ================= LFU =================
+
+/*
+ * O(1) LFU: frequency buckets in ascending order, each holding its
+ * pages most recent first. A hit moves a page into the next bucket up
+ * (created if that frequency has no pages yet); eviction takes the
+ * least recent page of the lowest bucket.
+ */
+struct vm_lfu {
+    struct vm_map map;
+    uint64_t *page;
+    int32_t *prev, *next, *bucket;
+    int used;
+
+    uint64_t *freq;
+    struct vm_list *pages;
+    int32_t *bprev, *bnext, *bfree;
+    int nfree, lowest;
+};
+
+static void lfu_destroy(struct vm_cache *v) {
+    struct vm_lfu *l = v->pdata;
+    if (!l) return;
+    vm_map_free(&l->map);
+    free(l->page);
+    free(l->prev);
+    free(l->next);
+    free(l->bucket);
+    free(l->freq);
+    free(l->pages);
+    free(l->bprev);
+    free(l->bnext);
+    free(l->bfree);
+    free(l);
+    v->pdata = NULL;
+}
+
+static int lfu_init(struct vm_cache *v) {
+    struct vm_lfu *l = calloc(1, sizeof(*l));
+    if (!(v->pdata = l)) return -1;
+
+    size_t f = (size_t)v->frames, nb = f + 1;
+    l->page = malloc(f * sizeof(uint64_t));
+    l->prev = malloc(f * sizeof(int32_t));
+    l->next = malloc(f * sizeof(int32_t));
+    l->bucket = malloc(f * sizeof(int32_t));
+    l->freq = malloc(nb * sizeof(uint64_t));
+    l->pages = malloc(nb * sizeof(struct vm_list));
+    l->bprev = malloc(nb * sizeof(int32_t));
+    l->bnext = malloc(nb * sizeof(int32_t));
+    l->bfree = malloc(nb * sizeof(int32_t));
+    if (!l->page || !l->prev || !l->next || !l->bucket || !l->freq || !l->pages ||
+        !l->bprev || !l->bnext || !l->bfree || vm_map_init(&l->map, v->frames) != 0) {
+        lfu_destroy(v);
+        return -1;
+    }
+    for (size_t b = 0; b < nb; b++) l->bfree[l->nfree++] = (int32_t)(nb - 1 - b);
+    l->lowest = -1;
+    return 0;
+}
+
+/* New empty bucket for frequency f, linked after bucket `after` (-1 = as the lowest). */
+static int lfu_bucket(struct vm_lfu *l, uint64_t f, int after) {
+    int b = l->bfree[--l->nfree];
+    l->freq[b] = f;
+    list_init(&l->pages[b]);
+    l->bprev[b] = after;
+    l->bnext[b] = (after >= 0) ? l->bnext[after] : l->lowest;
+    if (l->bnext[b] >= 0) l->bprev[l->bnext[b]] = b;
+    if (after >= 0) l->bnext[after] = b; else l->lowest = b;
+    return b;
+}
+
+static void lfu_unbucket(struct vm_lfu *l, int b) {
+    if (l->bprev[b] >= 0) l->bnext[l->bprev[b]] = l->bnext[b]; else l->lowest = l->bnext[b];
+    if (l->bnext[b] >= 0) l->bprev[l->bnext[b]] = l->bprev[b];
+    l->bfree[l->nfree++] = b;
+}
+
+static void lfu_run(struct vm_cache *v, const uint64_t *refs, size_t n) {
+    struct vm_lfu *l = v->pdata;
+    uint64_t hits = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t p = refs[i];
+        int32_t x = vm_map_find(&l->map, p);
+
+        if (x >= 0) {
+            int b = l->bucket[x];
+            int nb = l->bnext[b];
+            if (nb < 0 || l->freq[nb] != l->freq[b] + 1) nb = lfu_bucket(l, l->freq[b] + 1, b);
+            list_unlink(&l->pages[b], l->prev, l->next, x);
+            list_push(&l->pages[nb], l->prev, l->next, x);
+            l->bucket[x] = nb;
+            if (l->pages[b].len == 0) lfu_unbucket(l, b);
+            hits++;
+            continue;
+        }
+
+        if (l->used < v->frames) {
+            x = l->used++;
+        } else {
+            int b = l->lowest;
+            x = l->pages[b].tail;
+            list_unlink(&l->pages[b], l->prev, l->next, x);
+            vm_map_del(&l->map, l->page[x]);
+            if (l->pages[b].len == 0) lfu_unbucket(l, b);
+        }
+        int b1 = l->lowest;
+        if (b1 < 0 || l->freq[b1] != 1) b1 = lfu_bucket(l, 1, -1);
+        l->page[x] = p;
+        vm_map_put(&l->map, p, x);
+        list_push(&l->pages[b1], l->prev, l->next, x);
+        l->bucket[x] = b1;
+    }
+    v->hits += hits;
+    v->refs += n;
+}
+
+const struct vm_policy vm_lfu = { "LFU", lfu_init, lfu_destroy, lfu_run };
+
+// ================= ARC =================
+
+/*
+ * Adaptive Replacement Cache (Megiddo and Modha, FAST '03). T1 holds
+ * pages seen once recently, T2 pages seen at least twice; B1 and B2
+ * remember the pages recently evicted from each. A hit in a ghost list
+ * moves the target size p of T1 towards the list that would have kept
+ * the page. Ghosts carry no data, so at most 2 * frames entries exist.
+ */
+enum { ARC_T1, ARC_T2, ARC_B1, ARC_B2, ARC_LISTS };
+
+struct vm_arc {
+    struct vm_map map;
+    uint64_t *page;
+    int32_t *prev, *next, *free;
+    uint8_t *where;
+    int nfree;
+    struct vm_list l[ARC_LISTS];
+    double p;
+};
+
+static void arc_destroy(struct vm_cache *v) {
+    struct vm_arc *a = v->pdata;
+    if (!a) return;
+    vm_map_free(&a->map);
+    free(a->page);
+    free(a->prev);
+    free(a->next);
+    free(a->free);
+    free(a->where);
+    free(a);
+    v->pdata = NULL;
+}
+
+static int arc_init(struct vm_cache *v) {
+    struct vm_arc *a = calloc(1, sizeof(*a));
+    if (!(v->pdata = a)) return -1;
+
+    size_t n = 2 * (size_t)v->frames;
+    a->page = malloc(n * sizeof(uint64_t));
+    a->prev = malloc(n * sizeof(int32_t));
+    a->next = malloc(n * sizeof(int32_t));
+    a->free = malloc(n * sizeof(int32_t));
+    a->where = malloc(n);
+    if (!a->page || !a->prev || !a->next || !a->free || !a->where ||
+        vm_map_init(&a->map, (int)n) != 0) {
+        arc_destroy(v);
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) a->free[a->nfree++] = (int32_t)(n - 1 - i);
+    for (int k = 0; k < ARC_LISTS; k++) list_init(&a->l[k]);
+    return 0;
+}
+
+static void arc_move(struct vm_arc *a, int x, int to) {
+    list_unlink(&a->l[a->where[x]], a->prev, a->next, x);
+    list_push(&a->l[to], a->prev, a->next, x);
+    a->where[x] = (uint8_t)to;
+}
+
+static void arc_drop_lru(struct vm_arc *a, int list) {
+    int x = a->l[list].tail;
+    list_unlink(&a->l[list], a->prev, a->next, x);
+    vm_map_del(&a->map, a->page[x]);
+    a->free[a->nfree++] = x;
+}
+
+/* Evict one resident page into its ghost list, from T1 if it is over target. */
+static void arc_replace(struct vm_arc *a, int in_b2) {
+    int t1 = a->l[ARC_T1].len;
+    if (t1 > 0 && ((in_b2 && t1 == a->p) || t1 > a->p || a->l[ARC_T2].len == 0))
+        arc_move(a, a->l[ARC_T1].tail, ARC_B1);
+    else
+        arc_move(a, a->l[ARC_T2].tail, ARC_B2);
+}
+
+static void arc_run(struct vm_cache *v, const uint64_t *refs, size_t n) {
+    struct vm_arc *a = v->pdata;
+    struct vm_list *l = a->l;
+    int c = v->frames;
+    uint64_t hits = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t p = refs[i];
+        int32_t x = vm_map_find(&a->map, p);
+        int full = l[ARC_T1].len + l[ARC_T2].len >= c;
+
+        if (x >= 0 && a->where[x] <= ARC_T2) {
+            arc_move(a, x, ARC_T2);
+            hits++;
+        } else if (x >= 0 && a->where[x] == ARC_B1) {
+            double d = (l[ARC_B2].len > l[ARC_B1].len) ? (double)l[ARC_B2].len / l[ARC_B1].len : 1;
+            a->p = (a->p + d < c) ? a->p + d : c;
+            if (full) arc_replace(a, 0);
+            arc_move(a, x, ARC_T2);
+        } else if (x >= 0) {
+            double d = (l[ARC_B1].len > l[ARC_B2].len) ? (double)l[ARC_B1].len / l[ARC_B2].len : 1;
+            a->p = (a->p - d > 0) ? a->p - d : 0;
+            if (full) arc_replace(a, 1);
+            arc_move(a, x, ARC_T2);
+        } else {
+            int l1 = l[ARC_T1].len + l[ARC_B1].len;
+            int total = l1 + l[ARC_T2].len + l[ARC_B2].len;
+            if (l1 == c) {
+                if (l[ARC_T1].len < c) {
+                    arc_drop_lru(a, ARC_B1);
+                    if (full) arc_replace(a, 0);
+                } else {
+                    arc_drop_lru(a, ARC_T1);
+                }
+            } else if (total >= c) {
+                if (total == 2 * c) arc_drop_lru(a, ARC_B2);
+                if (full) arc_replace(a, 0);
+            }
+            x = a->free[--a->nfree];
+            a->page[x] = p;
+            a->where[x] = ARC_T1;
+            list_push(&l[ARC_T1], a->prev, a->next, x);
+            vm_map_put(&a->map, p, x);
+        }
+    }
+    v->hits += hits;
+    v->refs += n;
+}
+
+const struct vm_policy vm_arc = { "ARC", arc_init, arc_destroy, arc_run };
+
+int vm_cache_init(struct vm_cache *v, const struct vm_policy *policy, int frames) {
+    memset(v, 0, sizeof(*v));
+    v->policy = policy;
+    v->frames = frames;
+    return policy->init(v);
+}
+
+void vm_cache_free(struct vm_cache *v) {
+    if (v->policy) v->policy->destroy(v);
+}
+
+// ================= LRU STACK DISTANCE =================
+
+int vm_stack_init(struct vm_stack *s, const int *frames, int nsizes) {
+    memset(s, 0, sizeof(*s));
+    if (nsizes < 1 || nsizes > VM_MAX_SIZES) return -1;
+
+    s->nsizes = nsizes;
+    for (int j = 0; j < nsizes; j++) {
+        s->frames[j] = frames[j];
+        s->cap[j] = frames[j] - (j ? frames[j - 1] : 0);
+        s->last[j] = -1;
+        if (s->cap[j] <= 0) return -1;
+    }
+
+    size_t depth = (size_t)frames[nsizes - 1];
+    s->page = malloc(depth * sizeof(uint64_t));
+    s->prev = malloc(depth * sizeof(int32_t));
+    s->next = malloc(depth * sizeof(int32_t));
+    s->seg = malloc(depth);
+    s->head = s->tail = -1;
+    if (!s->page || !s->prev || !s->next || !s->seg || vm_map_init(&s->map, (int)depth) != 0) {
+        vm_stack_free(s);
+        return -1;
+    }
+    return 0;
+}
+
+void vm_stack_free(struct vm_stack *s) {
+    vm_map_free(&s->map);
+    free(s->page);
+    free(s->prev);
+    free(s->next);
+    free(s->seg);
+    s->page = NULL;
+    s->prev = s->next = NULL;
+    s->seg = NULL;
+}
+
+/* Unlink x from the stack, keeping its segment's bottom marker right. */
+static void stack_unlink(struct vm_stack *s, int x) {
+    int j = s->seg[x];
+    if (s->last[j] == x) s->last[j] = (--s->len[j] > 0) ? s->prev[x] : -1;
+    else s->len[j]--;
+
+    if (s->prev[x] >= 0) s->next[s->prev[x]] = s->next[x]; else s->head = s->next[x];
+    if (s->next[x] >= 0) s->prev[s->next[x]] = s->prev[x]; else s->tail = s->prev[x];
+}
+
+/* Put x on top, then push one page across each full boundary down to segment `upto`. */
+static void stack_push(struct vm_stack *s, int x, int upto) {
+    s->prev[x] = -1;
+    s->next[x] = s->head;
+    if (s->head >= 0) s->prev[s->head] = x; else s->tail = x;
+    s->head = x;
+    s->seg[x] = 0;
+    if (s->len[0]++ == 0) s->last[0] = x;
+
+    for (int j = 0; j < upto && s->len[j] > s->cap[j]; j++) {
+        int b = s->last[j];
+        s->last[j] = s->prev[b];
+        s->len[j]--;
+        s->seg[b] = (uint8_t)(j + 1);
+        if (s->len[j + 1]++ == 0) s->last[j + 1] = b;
+    }
+}
+
+void vm_stack_run(struct vm_stack *s, const uint64_t *refs, size_t n) {
+    int depth = s->frames[s->nsizes - 1];
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t p = refs[i];
+        int32_t x = vm_map_find(&s->map, p);
+
+        if (x >= 0) {
+            int j = s->seg[x];
+            s->seg_hits[j]++;
+            if (x == s->head) continue;
+            stack_unlink(s, x);
+            stack_push(s, x, j);
+            continue;
+        }
+
+        if (s->used < depth) {
+            x = s->used++;
+        } else {
+            x = s->tail;
+            stack_unlink(s, x);
+            vm_map_del(&s->map, s->page[x]);
+        }
+        s->page[x] = p;
+        vm_map_put(&s->map, p, x);
+        stack_push(s, x, s->nsizes - 1);
+    }
+    s->refs += n;
+}
+
+/* Hits of an LRU cache with frames[size] frames: every reference at a stack distance within it. */
+uint64_t vm_stack_hits(const struct vm_stack *s, int size) {
+    uint64_t h = 0;
+    for (int j = 0; j <= size; j++) h += s->seg_hits[j];
+    return h;
+}
@@ -0,0 +1,95 @@
+#ifndef VM_REPLACE_H
+#define VM_REPLACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ================= PAGE MAP =================
+
+/*
+ * Page number -> slot, open addressing with linear probing and
+ * backward-shift deletion, sized once for the most pages a cache can
+ * track. Memory depends on the frame count only, never on how many
+ * references or distinct pages go by.
+ */
+struct vm_map {
+    uint64_t *key;
+    int32_t *val;       // -1 = empty
+    uint64_t mask;
+    int shift;
+};
+
+int     vm_map_init(struct vm_map *m, int capacity);
+void    vm_map_free(struct vm_map *m);
+int32_t vm_map_find(const struct vm_map *m, uint64_t page);
+void    vm_map_put(struct vm_map *m, uint64_t page, int32_t slot);
+void    vm_map_del(struct vm_map *m, uint64_t page);
+
+// ================= REPLACEMENT POLICIES =================
+
+/*
+ * One cache of `frames` page frames. A policy owns its state in pdata,
+ * sized in init() from the frame count, so every reference is O(1) and
+ * allocation-free. run() replays a chunk of references and adds to
+ * hits/refs.
+ */
+struct vm_cache;
+
+struct vm_policy {
+    const char *name;
+    int  (*init)(struct vm_cache *v);
+    void (*destroy)(struct vm_cache *v);
+    void (*run)(struct vm_cache *v, const uint64_t *refs, size_t n);
+};
+
+struct vm_cache {
+    const struct vm_policy *policy;
+    int frames;
+    uint64_t hits, refs;
+    void *pdata;
+};
+
+extern const struct vm_policy vm_fifo;
+extern const struct vm_policy vm_clock;
+extern const struct vm_policy vm_lfu;
+extern const struct vm_policy vm_arc;
+
+int  vm_cache_init(struct vm_cache *v, const struct vm_policy *policy, int frames);
+void vm_cache_free(struct vm_cache *v);
+
+// ================= LRU STACK DISTANCE =================
+
+/*
+ * LRU for several frame counts in one pass (Mattson et al.). LRU is a
+ * stack algorithm: a cache of F frames holds exactly the top F pages of
+ * the recency stack, so a reference hits every cache at least as large
+ * as its stack distance. The stack is kept only as deep as the largest
+ * frame count and cut into one segment per frame count; a reference
+ * only needs its segment (stored per page) and moves one boundary page
+ * down per segment above it, O(number of frame counts) whatever the
+ * depth.
+ */
+#define VM_MAX_SIZES 32
+
+struct vm_stack {
+    int nsizes;
+    int frames[VM_MAX_SIZES];   // ascending
+    int cap[VM_MAX_SIZES];      // pages per segment
+    int len[VM_MAX_SIZES];
+    int last[VM_MAX_SIZES];     // deepest page of each segment, -1 when empty
+    uint64_t seg_hits[VM_MAX_SIZES];
+    uint64_t refs;
+
+    uint64_t *page;
+    int32_t *prev, *next;
+    uint8_t *seg;
+    int head, tail, used;
+    struct vm_map map;
+};
+
+int      vm_stack_init(struct vm_stack *s, const int *frames, int nsizes);
+void     vm_stack_free(struct vm_stack *s);
+void     vm_stack_run(struct vm_stack *s, const uint64_t *refs, size_t n);
+uint64_t vm_stack_hits(const struct vm_stack *s, int size);
+
+#endif
@@ -0,0 +1,369 @@
+#define _POSIX_C_SOURCE 200809L
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sched_calib.h"
+#include "sched_rand.h"
+#include "vm_replace.h"
+
+// ================= PAGE REPLACEMENT SIMULATOR =================
+
+/*
+ * Replays one page-reference string against every selected policy at
+ * every frame count. The string is read (or generated) in fixed chunks
+ * and each chunk is handed to all caches before the next is produced,
+ * so memory depends on the frame counts only and a trace of any length
+ * can stream through once, from a file or a pipe. LRU covers all frame
+ * counts with one stack-distance pass; the other policies are not stack
+ * algorithms (FIFO shows Belady's anomaly) and keep one cache per frame
+ * count.
+ */
+#define VM_CHUNK 65536
+#define VM_MAX_POLICIES 5
+
+enum ref_source { SRC_UNIFORM, SRC_ZIPF, SRC_LOOP, SRC_TEXT, SRC_BINARY };
+
+struct ref_stream {
+    enum ref_source src;
+    uint64_t pages, left;   // synthetic only
+    uint64_t pos;
+    double skew;
+    struct sched_rng rng;
+    FILE *f;
+    unsigned page_shift;    // trace holds byte addresses when > 0
+    char *line;
+    size_t cap;
+
+    // Zipf rejection-inversion constants
+    double h_x1, h_n, s;
+};
+
+// ================= ZIPF SAMPLING =================
+
+/*
+ * Bounded Zipf by rejection-inversion (Hormann and Derflinger, 1996):
+ * invert the integral of x^-skew over [1.5, N + 0.5] and accept the
+ * rounded point unless it lands in the sliver where the step function
+ * and the integral disagree. O(1) per sample with no table, whatever N.
+ */
+static double expm1_over(double x) { return fabs(x) > 1e-8 ? expm1(x) / x : 1 + x / 2; }
+static double log1p_over(double x) { return fabs(x) > 1e-8 ? log1p(x) / x : 1 - x / 2; }
+
+static double zipf_h(const struct ref_stream *r, double x) { return exp(-r->skew * log(x)); }
+
+static double zipf_H(const struct ref_stream *r, double x) {
+    double lx = log(x);
+    return expm1_over((1 - r->skew) * lx) * lx;
+}
+
+static double zipf_Hinv(const struct ref_stream *r, double x) {
+    double t = x * (1 - r->skew);
+    if (t < -1) t = -1;
+    return exp(log1p_over(t) * x);
+}
+
+static void zipf_init(struct ref_stream *r) {
+    r->h_x1 = zipf_H(r, 1.5) - 1;
+    r->h_n = zipf_H(r, (double)r->pages + 0.5);
+    r->s = 2 - zipf_Hinv(r, zipf_H(r, 2.5) - zipf_h(r, 2));
+}
+
+static double u01(struct sched_rng *rng) {
+    return (rng_next32(rng) + 0.5) / 4294967296.0;
+}
+
+/* Rank 1 is the most popular page; ranks map to pages 0..N-1. */
+static uint64_t zipf_next(struct ref_stream *r) {
+    for (;;) {
+        double u = r->h_n + u01(&r->rng) * (r->h_x1 - r->h_n);
+        double x = zipf_Hinv(r, u);
+        double k = floor(x + 0.5);
+        if (k < 1) k = 1;
+        if (k > (double)r->pages) k = (double)r->pages;
+        if (k - x <= r->s || u >= zipf_H(r, k + 0.5) - zipf_h(r, k)) return (uint64_t)k - 1;
+    }
+}
+
+// ================= REFERENCE STREAMS =================
+
+/* Text traces: one reference per line, optionally after an access-type letter ("R 0x7f10"). */
+static int parse_line(struct ref_stream *r, uint64_t *page) {
+    while (getline(&r->line, &r->cap, r->f) > 0) {
+        char *p = r->line, *end;
+        while (isspace((unsigned char)*p)) p++;
+        if (*p == '#' || *p == '\0') continue;
+        if (isalpha((unsigned char)*p) && isspace((unsigned char)p[1])) p += 2;
+        uint64_t v = strtoull(p, &end, 0);
+        if (end == p) continue;
+        *page = v >> r->page_shift;
+        return 1;
+    }
+    return 0;
+}
+
+static size_t stream_fill(struct ref_stream *r, uint64_t *buf, size_t max) {
+    size_t n = 0;
+
+    switch (r->src) {
+    case SRC_UNIFORM:
+        for (; n < max && r->left; n++, r->left--) {
+            uint64_t hi = rng_next32(&r->rng);
+            buf[n] = (hi << 32 | rng_next32(&r->rng)) % r->pages;
+        }
+        break;
+    case SRC_ZIPF:
+        for (; n < max && r->left; n++, r->left--) buf[n] = zipf_next(r);
+        break;
+    case SRC_LOOP:
+        for (; n < max && r->left; n++, r->left--) {
+            buf[n] = r->pos;
+            if (++r->pos == r->pages) r->pos = 0;
+        }
+        break;
+    case SRC_TEXT:
+        while (n < max && parse_line(r, &buf[n])) n++;
+        break;
+    case SRC_BINARY:
+        n = fread(buf, sizeof(uint64_t), max, r->f);
+        if (r->page_shift)
+            for (size_t i = 0; i < n; i++) buf[i] >>= r->page_shift;
+        break;
+    }
+    return n;
+}
+
+// ================= SWEEP =================
+
+struct vm_sweep {
+    int nsizes;
+    int frames[VM_MAX_SIZES];
+    int npol;
+    const struct vm_policy *pol[VM_MAX_POLICIES];  // NULL = LRU by stack distance
+    struct vm_stack lru;
+    struct vm_cache *cache;                         // [policy][size], non-LRU only
+    uint64_t refs;
+};
+
+static const struct {
+    const char *name;
+    const struct vm_policy *pol;
+} policy_names[] = {
+    { "fifo", &vm_fifo }, { "lru", NULL }, { "clock", &vm_clock }, { "lfu", &vm_lfu }, { "arc", &vm_arc },
+};
+
+static int parse_policies(struct vm_sweep *w, char *list) {
+    for (char *tok = strtok(list, ","); tok; tok = strtok(NULL, ",")) {
+        size_t i = 0;
+        while (i < sizeof(policy_names) / sizeof(policy_names[0]) && strcasecmp(tok, policy_names[i].name))
+            i++;
+        if (i == sizeof(policy_names) / sizeof(policy_names[0]) || w->npol == VM_MAX_POLICIES) {
+            fprintf(stderr, "Unknown policy %s\n", tok);
+            return -1;
+        }
+        w->pol[w->npol++] = policy_names[i].pol;
+    }
+    return 0;
+}
+
+static int cmp_int(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+static int parse_frames(struct vm_sweep *w, char *list) {
+    for (char *tok = strtok(list, ","); tok; tok = strtok(NULL, ",")) {
+        long f = atol(tok);
+        if (f < 1 || f > (1L << 28) || w->nsizes == VM_MAX_SIZES) {
+            fprintf(stderr, "Bad frame count %s (1..%ld, at most %d counts)\n", tok, 1L << 28, VM_MAX_SIZES);
+            return -1;
+        }
+        w->frames[w->nsizes++] = (int)f;
+    }
+    qsort(w->frames, w->nsizes, sizeof(int), cmp_int);
+    for (int j = 1; j < w->nsizes; j++) {
+        if (w->frames[j] == w->frames[j - 1]) {
+            fprintf(stderr, "Frame count %d given twice\n", w->frames[j]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int sweep_init(struct vm_sweep *w) {
+    int lru = 0;
+    w->cache = calloc((size_t)w->npol * w->nsizes, sizeof(struct vm_cache));
+    if (!w->cache) return -1;
+    for (int k = 0; k < w->npol; k++) {
+        if (!w->pol[k]) {
+            lru = 1;
+            continue;
+        }
+        for (int j = 0; j < w->nsizes; j++)
+            if (vm_cache_init(&w->cache[k * w->nsizes + j], w->pol[k], w->frames[j]) != 0) return -1;
+    }
+    return lru ? vm_stack_init(&w->lru, w->frames, w->nsizes) : 0;
+}
+
+static void sweep_free(struct vm_sweep *w) {
+    if (w->cache)
+        for (int i = 0; i < w->npol * w->nsizes; i++) vm_cache_free(&w->cache[i]);
+    free(w->cache);
+    vm_stack_free(&w->lru);
+}
+
+static void sweep_run(struct vm_sweep *w, const uint64_t *refs, size_t n) {
+    for (int k = 0; k < w->npol; k++) {
+        if (!w->pol[k]) {
+            vm_stack_run(&w->lru, refs, n);
+            continue;
+        }
+        for (int j = 0; j < w->nsizes; j++) {
+            struct vm_cache *v = &w->cache[k * w->nsizes + j];
+            v->policy->run(v, refs, n);
+        }
+    }
+    w->refs += n;
+}
+
+static void print_results(const struct vm_sweep *w, double fault_cost) {
+    const char *rule = "+--------+--------+----------------+----------+------------------+\n";
+
+    printf("%s", rule);
+    printf("| Frames | Policy |     Faults     | Hit Rate |   Paging Stall   |\n");
+    printf("%s", rule);
+    for (int j = 0; j < w->nsizes; j++) {
+        for (int k = 0; k < w->npol; k++) {
+            uint64_t hits = w->pol[k] ? w->cache[k * w->nsizes + j].hits : vm_stack_hits(&w->lru, j);
+            uint64_t faults = w->refs - hits;
+            char size[16] = "", stall[32] = "-";
+            if (k == 0) snprintf(size, sizeof(size), "%d", w->frames[j]);
+            if (fault_cost > 0) snprintf(stall, sizeof(stall), "%.4f", faults * fault_cost);
+            printf("| %-6s | %-6s | %-14llu | %7.3f%% | %-16s |\n", size,
+                   w->pol[k] ? w->pol[k]->name : "LRU", (unsigned long long)faults,
+                   w->refs ? 100.0 * hits / w->refs : 0.0, stall);
+        }
+        printf("%s", rule);
+    }
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-f frames[,frames...]] [-p policy[,policy...]] [-w fault_cost]\n"
+            "          [-g uniform|zipf|loop] [-N pages] [-R refs] [-z skew] [-s seed]\n"
+            "          [-b page_size] [-B] [trace | -]\n"
+            "Policies: fifo, lru, clock, lfu, arc\n", prog);
+}
+
+int main(int argc, char **argv) {
+    struct vm_sweep w = { 0 };
+    struct ref_stream r = { .src = SRC_ZIPF, .pages = 1000, .left = 1000000, .skew = 0.9 };
+    const char *gen = NULL;
+    uint64_t seed = 1;
+    long page_size = 4096;
+    int binary = 0, opt;
+    double fault_cost = -1;
+    char default_frames[] = "16,32,64,128,256";
+
+    while ((opt = getopt(argc, argv, "f:p:w:g:N:R:z:s:b:B")) != -1) {
+        switch (opt) {
+        case 'f':
+            if (parse_frames(&w, optarg) != 0) return 1;
+            break;
+        case 'p':
+            if (parse_policies(&w, optarg) != 0) return 1;
+            break;
+        case 'w': fault_cost = atof(optarg); break;
+        case 'g': gen = optarg; break;
+        case 'N': r.pages = strtoull(optarg, NULL, 0); break;
+        case 'R': r.left = strtoull(optarg, NULL, 0); break;
+        case 'z': r.skew = atof(optarg); break;
+        case 's': seed = strtoull(optarg, NULL, 0); break;
+        case 'b':
+            page_size = atol(optarg);
+            if (page_size < 1 || (page_size & (page_size - 1))) {
+                fprintf(stderr, "Page size must be a power of two\n");
+                return 1;
+            }
+            while ((1L << r.page_shift) < page_size) r.page_shift++;
+            break;
+        case 'B': binary = 1; break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (w.nsizes == 0) parse_frames(&w, default_frames);
+    if (w.npol == 0)
+        for (size_t i = 0; i < sizeof(policy_names) / sizeof(policy_names[0]); i++)
+            w.pol[w.npol++] = policy_names[i].pol;
+
+    if (optind < argc) {
+        r.src = binary ? SRC_BINARY : SRC_TEXT;
+        r.f = strcmp(argv[optind], "-") ? fopen(argv[optind], binary ? "rb" : "r") : stdin;
+        if (!r.f) {
+            perror(argv[optind]);
+            return 1;
+        }
+    } else {
+        if (gen && !strcmp(gen, "uniform")) r.src = SRC_UNIFORM;
+        else if (gen && !strcmp(gen, "loop")) r.src = SRC_LOOP;
+        else if (gen && strcmp(gen, "zipf")) {
+            usage(argv[0]);
+            return 1;
+        }
+        if (r.pages < 1 || (r.src == SRC_ZIPF && r.skew <= 0)) {
+            usage(argv[0]);
+            return 1;
+        }
+        rng_init(&r.rng, seed, 0);
+        if (r.src == SRC_ZIPF) zipf_init(&r);
+    }
+
+    uint64_t *buf = malloc(VM_CHUNK * sizeof(uint64_t));
+    if (!buf || sweep_init(&w) != 0) {
+        fprintf(stderr, "Out of memory for %d frames\n", w.frames[w.nsizes - 1]);
+        return 1;
+    }
+
+    printf("CampusConnect Page Replacement Simulator (Linux)\n");
+    if (r.src == SRC_TEXT || r.src == SRC_BINARY)
+        printf("Reference String: %s (%s)\n", argv[optind], binary ? "binary" : "text");
+    else
+        printf("Reference String: %s, %llu pages, %llu references, skew %.2f, seed %llu\n",
+               r.src == SRC_ZIPF ? "zipf" : r.src == SRC_UNIFORM ? "uniform" : "loop",
+               (unsigned long long)r.pages, (unsigned long long)r.left, r.skew, (unsigned long long)seed);
+
+    struct timespec s, e;
+    size_t n;
+    clock_gettime(CLOCK_MONOTONIC, &s);
+    while ((n = stream_fill(&r, buf, VM_CHUNK)) > 0) sweep_run(&w, buf, n);
+    clock_gettime(CLOCK_MONOTONIC, &e);
+    double secs = elapsed_sec(&s, &e);
+    printf("Replay Time: %.3f seconds (%.1f M references/s)\n", secs,
+           secs > 0 ? w.refs / secs / 1e6 : 0.0);
+
+    // Each fault reads its page back in from swap
+    if (fault_cost < 0) {
+        struct swap_calib cal;
+        struct swap_model m;
+        if (calib_get(&cal) == 0) {
+            calib_swap_model(&cal, &m);
+            fault_cost = swap_in_cost(&m, (double)page_size);
+        } else {
+            fprintf(stderr, "Calibration failed; paging stall not shown\n");
+        }
+    }
+    if (fault_cost > 0) printf("Fault Cost: %.6f units per %ld-byte page\n", fault_cost, page_size);
+    print_results(&w, fault_cost);
+
+    sweep_free(&w);
+    free(buf);
+    free(r.line);
+    if (r.f && r.f != stdin) fclose(r.f);
+    return 0;
+}
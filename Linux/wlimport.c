@@ -0,0 +1,33 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <time.h>
+
+#include "sched_engine.h"
+
+// ================= CSV -> .wl CONVERTER =================
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <input.csv|-> <output.wl>\n", argv[0]);
+        return 1;
+    }
+
+    FILE *in = (argv[1][0] == '-' && argv[1][1] == '\0') ? stdin : fopen(argv[1], "r");
+    if (!in) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    struct timespec s, e;
+    clock_gettime(CLOCK_MONOTONIC, &s);
+    long n = workload_import_csv(in, argv[2]);
+    clock_gettime(CLOCK_MONOTONIC, &e);
+    if (in != stdin) fclose(in);
+
+    if (n < 0) {
+        fprintf(stderr, "Import failed\n");
+        return 1;
+    }
+
+    printf("Imported %ld processes into %s in %.3f seconds\n", n, argv[2], elapsed_sec(&s, &e));
+    return 0;
+}